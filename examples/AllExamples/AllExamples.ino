@@ -88,5 +88,25 @@ void loop() {
     vfd.clearWindow(0);
     example_multiple_graphics_logical_or(vfd);
     delay(1000);
+
+    Serial.println("Running: Framebuffer Text");
+    vfd.clearWindow(0);
+    example_framebuffer_text(vfd);
+    delay(1000);
+
+    Serial.println("Running: Sprites");
+    vfd.clearWindow(0);
+    example_sprites(vfd);
+    delay(1000);
+
+    Serial.println("Running: Scroll Canvas");
+    vfd.clearWindow(0);
+    example_scroll_canvas(vfd);
+    delay(1000);
+
+    Serial.println("Running: Strip Rendering");
+    vfd.clearWindow(0);
+    example_strip_rendering(vfd);
+    delay(1000);
 }
 
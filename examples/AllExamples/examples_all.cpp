@@ -2,42 +2,25 @@
 #include <math.h>
 #include <vector>
 
-// Helper to clear bitmap
-static void clear_bitmap(std::vector<uint8_t>& bitmap) {
-    std::fill(bitmap.begin(), bitmap.end(), 0);
-}
-
 // --------------------------------------------------------------------------
 // animated_circle_filling.py (Logic seems to be radial lines in the file I read, 
 // but I'll implement what was in the file)
 // --------------------------------------------------------------------------
 void example_animated_circle_filling(FutabaNAGP1250& vfd) {
-    uint16_t width = 140;
-    uint16_t height = 32;
-    std::vector<uint8_t> bitmap(width * height, 0);
-    
-    uint16_t cx = 70;
-    uint16_t cy = 16; // Centered vertically
-    int angle = 0;
-    int step_deg = 5;
+    FutabaNAGP1250Framebuffer frame(140, 32);
+    FutabaNAGP1250FrameScheduler scheduler(vfd, frame, 20);
+
+    // The Python example keeps drawing into the same bitmap, so the lines accumulate. Frame i
+    // shows every line up to angle 5 * i, which stays correct if the scheduler drops a frame.
+    scheduler.setRender([](FutabaNAGP1250Framebuffer& f, uint32_t index, void*) {
+        for (uint32_t i = 0; i <= index; ++i) {
+            FutabaNAGP1250::drawGraphicLines(f, {{70, 16, static_cast<float>(i * 5 % 360), 10}});
+        }
+    });
 
     // Run one full rotation
-    for (int i = 0; i < 360 / step_deg; ++i) {
-        // In the python example it accumulated lines? 
-        // "bitmap = vfd.draw_graphic_lines(bitmap=bitmap...)"
-        // If it re-uses bitmap without clearing, it accumulates.
-        // The python code: "bitmap = [[0...]] ... while True: bitmap = vfd.draw..."
-        // Yes, it accumulates.
-        
-        FutabaNAGP1250::drawGraphicLines(bitmap, width, height, {
-            {static_cast<int16_t>(cx), static_cast<int16_t>(cy), static_cast<float>(angle), 10}
-        });
-
-        auto packed = FutabaNAGP1250::packBitmap(bitmap, width, height);
-        vfd.displayGraphicImage(packed, width, height);
-        
-        angle = (angle + step_deg) % 360;
-        delay(50); // Animation speed control
+    while (scheduler.frameIndex() < 360 / 5) {
+        scheduler.service();
     }
 }
 
@@ -45,39 +28,22 @@ void example_animated_circle_filling(FutabaNAGP1250& vfd) {
 // animated_pixel_blocks.py
 // --------------------------------------------------------------------------
 void example_animated_pixel_blocks(FutabaNAGP1250& vfd) {
-    uint16_t width = 140;
-    uint16_t height = 32;
-    std::vector<uint8_t> bitmap(width * height, 0);
-    
-    int block_sizes[] = {1, 2, 4};
-    int current_size_idx = 0;
-    int loop_count = 0;
-
-    // Run for a while
-    for (int i = 0; i < 50; ++i) {
-        int block_size = block_sizes[current_size_idx];
-        
-        // Generate random blocks
-        for (int y = 0; y < height; y += block_size) {
-            for (int x = 0; x < width; x += block_size) {
-                uint8_t val = random(2); // 0 or 1
-                for (int by = 0; by < block_size && (y + by) < height; ++by) {
-                    for (int bx = 0; bx < block_size && (x + bx) < width; ++bx) {
-                        bitmap[(y + by) * width + (x + bx)] = val;
-                    }
-                }
+    FutabaNAGP1250Framebuffer frame(140, 32);
+    FutabaNAGP1250FrameScheduler scheduler(vfd, frame, 10);
+
+    // Random blocks, switching between 1, 2 and 4 pixel blocks every 5 frames.
+    scheduler.setRender([](FutabaNAGP1250Framebuffer& f, uint32_t index, void*) {
+        static const int block_sizes[] = {1, 2, 4};
+        const int block_size = block_sizes[index / 5 % 3];
+        for (int y = 0; y < f.height(); y += block_size) {
+            for (int x = 0; x < f.width(); x += block_size) {
+                f.fillRect(x, y, block_size, block_size, random(2));
             }
         }
+    });
 
-        auto packed = FutabaNAGP1250::packBitmap(bitmap, width, height);
-        vfd.displayGraphicImage(packed, width, height);
-
-        loop_count++;
-        if (loop_count >= 5) {
-            loop_count = 0;
-            current_size_idx = (current_size_idx + 1) % 3;
-        }
-        delay(100);
+    while (scheduler.frameIndex() < 50) {
+        scheduler.service();
     }
 }
 
@@ -87,24 +53,16 @@ void example_animated_pixel_blocks(FutabaNAGP1250& vfd) {
 void example_animated_radial_lines(FutabaNAGP1250& vfd) {
     // This seems very similar to circle filling in the provided code snippet
     // I'll implement a variant that clears the bitmap each time for a "radar" effect
-    uint16_t width = 140;
-    uint16_t height = 32;
-    std::vector<uint8_t> bitmap(width * height, 0);
-    
-    uint16_t cx = 70;
-    uint16_t cy = 16;
-    int angle = 0;
-
-    for (int i = 0; i < 360; i += 5) {
-        clear_bitmap(bitmap);
-        FutabaNAGP1250::drawGraphicLines(bitmap, width, height, {
-            {static_cast<int16_t>(cx), static_cast<int16_t>(cy), static_cast<float>(angle), 30}
-        });
-
-        auto packed = FutabaNAGP1250::packBitmap(bitmap, width, height);
-        vfd.displayGraphicImage(packed, width, height);
-        angle = (angle + 5) % 360;
-        // No delay, run fast
+    FutabaNAGP1250Framebuffer frame(140, 32);
+    FutabaNAGP1250FrameScheduler scheduler(vfd, frame, 60);
+
+    scheduler.setRender([](FutabaNAGP1250Framebuffer& f, uint32_t index, void*) {
+        f.clear();
+        FutabaNAGP1250::drawGraphicLines(f, {{70, 16, static_cast<float>(index * 5 % 360), 30}});
+    });
+
+    while (scheduler.frameIndex() < 360 / 5) {
+        scheduler.service();
     }
 }
 
@@ -112,47 +70,46 @@ void example_animated_radial_lines(FutabaNAGP1250& vfd) {
 // animated_waveforms.py
 // --------------------------------------------------------------------------
 void example_animated_waveforms(FutabaNAGP1250& vfd) {
-    uint16_t width = 140;
-    uint16_t height = 32;
-    std::vector<uint8_t> bitmap(width * height, 0);
-    
-    float phase = 0;
-    
-    for (int i = 0; i < 100; ++i) {
-        clear_bitmap(bitmap);
+    FutabaNAGP1250Framebuffer frame(140, 32);
+    FutabaNAGP1250FrameScheduler scheduler(vfd, frame, 50);
+
+    scheduler.setRender([](FutabaNAGP1250Framebuffer& f, uint32_t index, void*) {
+        const float phase = index * 0.2f;
+        f.clear();
         // Draw sine wave
-        for (int x = 0; x < width; ++x) {
+        for (int x = 0; x < f.width(); ++x) {
             int y = 16 + static_cast<int>(10 * sin((x * 0.1) + phase));
-            if (y >= 0 && y < height) {
-                bitmap[y * width + x] = 1;
-            }
+            f.setPixel(x, y);
         }
-        
-        auto packed = FutabaNAGP1250::packBitmap(bitmap, width, height);
-        vfd.displayGraphicImage(packed, width, height);
-        phase += 0.2f;
-        delay(20);
+    });
+
+    while (scheduler.frameIndex() < 100) {
+        scheduler.service();
     }
+    Serial.print(F("Waveforms: dropped "));
+    Serial.print(scheduler.framesDropped());
+    Serial.print(F(" frames, p50/p99 latency "));
+    Serial.print(scheduler.latencyPercentile(50));
+    Serial.print(F("/"));
+    Serial.print(scheduler.latencyPercentile(99));
+    Serial.println(F(" us"));
 }
 
 // --------------------------------------------------------------------------
 // circles_lines_circuit_traces.py
 // --------------------------------------------------------------------------
 void example_circles_lines_circuit_traces(FutabaNAGP1250& vfd) {
-    uint16_t width = 140;
-    uint16_t height = 32;
-    std::vector<uint8_t> bitmap(width * height, 0);
+    FutabaNAGP1250Framebuffer frame(140, 32);
     
-    FutabaNAGP1250::drawGraphicCircle(bitmap, 20, 16, 10, width, height);
-    FutabaNAGP1250::drawGraphicCircleFilled(bitmap, 50, 16, 8, width, height);
+    FutabaNAGP1250::drawGraphicCircle(frame, 20, 16, 10);
+    FutabaNAGP1250::drawGraphicCircleFilled(frame, 50, 16, 8);
     
     // Connect them with lines
-    FutabaNAGP1250::drawGraphicLines(bitmap, width, height, {
+    FutabaNAGP1250::drawGraphicLines(frame, {
         {30, 16, 0, 20}
     });
     
-    auto packed = FutabaNAGP1250::packBitmap(bitmap, width, height);
-    vfd.displayGraphicImage(packed, width, height);
+    vfd.displayGraphicImage(frame);
     delay(2000);
 }
 
@@ -160,20 +117,17 @@ void example_circles_lines_circuit_traces(FutabaNAGP1250& vfd) {
 // graphics_and_text.py
 // --------------------------------------------------------------------------
 void example_graphics_and_text(FutabaNAGP1250& vfd) {
-    uint16_t width = 140;
-    uint16_t height = 32;
-    std::vector<uint8_t> bitmap(width * height, 0);
+    FutabaNAGP1250Framebuffer frame(140, 32);
     
     // Draw some framing
-    FutabaNAGP1250::drawGraphicLines(bitmap, width, height, {
+    FutabaNAGP1250::drawGraphicLines(frame, {
         {0, 0, 0, 140},
         {0, 31, 0, 140},
         {0, 0, 270, 32},
         {139, 0, 270, 32}
     });
     
-    auto packed = FutabaNAGP1250::packBitmap(bitmap, width, height);
-    vfd.displayGraphicImage(packed, width, height);
+    vfd.displayGraphicImage(frame);
     
     vfd.setCursorPosition(20, 1);
     vfd.writeText("Graphics & Text");
@@ -184,15 +138,12 @@ void example_graphics_and_text(FutabaNAGP1250& vfd) {
 // graphics_text_boxes.py
 // --------------------------------------------------------------------------
 void example_graphics_text_boxes(FutabaNAGP1250& vfd) {
-    uint16_t width = 140;
-    uint16_t height = 32;
-    std::vector<uint8_t> bitmap(width * height, 0);
+    FutabaNAGP1250Framebuffer frame(140, 32);
     
-    FutabaNAGP1250::drawGraphicBox(bitmap, 10, 5, 40, 22, width, height, 3, false);
-    FutabaNAGP1250::drawGraphicBox(bitmap, 60, 5, 40, 22, width, height, 0, true);
+    FutabaNAGP1250::drawGraphicBox(frame, 10, 5, 40, 22, 3, false);
+    FutabaNAGP1250::drawGraphicBox(frame, 60, 5, 40, 22, 0, true);
     
-    auto packed = FutabaNAGP1250::packBitmap(bitmap, width, height);
-    vfd.displayGraphicImage(packed, width, height);
+    vfd.displayGraphicImage(frame);
     
     vfd.setWriteLogic(FutabaNAGP1250::WRITE_MODE_XOR);
     vfd.setCursorPosition(75, 1);
@@ -235,23 +186,143 @@ void example_multiple_graphics_logical_or(FutabaNAGP1250& vfd) {
     vfd.clearWindow(0);
     vfd.setWriteLogic(FutabaNAGP1250::WRITE_MODE_OR);
     
-    uint16_t width = 140;
-    uint16_t height = 32;
-    std::vector<uint8_t> bitmap(width * height, 0);
+    FutabaNAGP1250Framebuffer frame(140, 32);
     
     // Draw something
-    FutabaNAGP1250::drawGraphicCircleFilled(bitmap, 40, 16, 15, width, height);
-    auto packed = FutabaNAGP1250::packBitmap(bitmap, width, height);
-    vfd.displayGraphicImage(packed, width, height);
+    FutabaNAGP1250::drawGraphicCircleFilled(frame, 40, 16, 15);
+    vfd.displayGraphicImage(frame);
     
     // Draw something else overlapping
-    clear_bitmap(bitmap);
-    FutabaNAGP1250::drawGraphicBox(bitmap, 30, 10, 60, 12, width, height, 0, true);
-    packed = FutabaNAGP1250::packBitmap(bitmap, width, height);
+    frame.clear();
+    FutabaNAGP1250::drawGraphicBox(frame, 30, 10, 60, 12, 0, true);
     
     // Since we are in OR mode, this should merge
-    vfd.displayGraphicImage(packed, width, height);
+    vfd.displayGraphicImage(frame);
     
     delay(2000);
 }
 
+
+// --------------------------------------------------------------------------
+// Text boxes drawn into the framebuffer: the same screen as graphics_text_boxes, plus a live
+// counter, without hardware text. Each update is one dirty-region flush, so the write logic
+// must be NORMAL for the uploaded bytes to replace what is shown.
+// --------------------------------------------------------------------------
+void example_framebuffer_text(FutabaNAGP1250& vfd) {
+    vfd.setWriteLogic(FutabaNAGP1250::WRITE_MODE_NORMAL);
+    FutabaNAGP1250Framebuffer frame(140, 32);
+    FutabaNAGP1250TextRenderer text;
+
+    FutabaNAGP1250::drawGraphicBox(frame, 10, 5, 40, 22, 3, false);
+    FutabaNAGP1250::drawGraphicBox(frame, 60, 5, 40, 22, 0, true);
+    text.drawText(frame, 30 - text.measureText("OR") / 2, 12, "OR");
+    text.drawText(frame, 80 - text.measureText("XOR") / 2, 12, "XOR", false);
+    vfd.displayGraphicImage(frame);
+    frame.clearDirty();
+
+    // Opaque text overwrites the previous value in place; unchanged digits are not resent.
+    text.setOpaque(true);
+    for (int count = 0; count <= 100; ++count) {
+        char value[8];
+        snprintf(value, sizeof(value), "%3d", count);
+        text.drawText(frame, 110, 12, value);
+        vfd.flush(frame);
+        delay(20);
+    }
+    delay(2000);
+}
+
+// --------------------------------------------------------------------------
+// Sprites composed in RAM: a ship crossing the screen and back (mirrored on the way back)
+// over a fixed background, one dirty-region flush per frame.
+// --------------------------------------------------------------------------
+void example_sprites(FutabaNAGP1250& vfd) {
+    static const uint8_t ship[8] PROGMEM = {0x18, 0x3C, 0x7E, 0xDB, 0xFF, 0x7E, 0x24, 0x42};
+
+    FutabaNAGP1250Framebuffer background(140, 32);
+    for (uint16_t x = 0; x < 140; x += 10) {
+        background.setPixel(x, (x * 7) % 32);
+    }
+    FutabaNAGP1250::drawGraphicLine(background, 0, 31, 139, 31);
+
+    FutabaNAGP1250Framebuffer frame(140, 32);
+    FutabaNAGP1250FrameScheduler scheduler(vfd, frame, 30);
+    scheduler.setRender([](FutabaNAGP1250Framebuffer& f, uint32_t index, void* context) {
+        const FutabaNAGP1250Framebuffer& scenery = *static_cast<const FutabaNAGP1250Framebuffer*>(context);
+        const int16_t step = index % 264;
+        const bool back = step >= 132;
+        const int16_t x = back ? 263 - step : step;
+        const int16_t y = 12 + (step % 16 < 8 ? step % 8 : 7 - step % 8);
+        FutabaNAGP1250::drawSprite(f, scenery, 0, 0);
+        FutabaNAGP1250::drawSpriteP(f, ship, 8, 8, x, y, FutabaNAGP1250::WRITE_MODE_XOR, back);
+    }, &background);
+
+    // Each flush replaces the ship's old position; under OR it would leave a trail.
+    vfd.setWriteLogic(FutabaNAGP1250::WRITE_MODE_NORMAL);
+    while (scheduler.frameIndex() < 264) {
+        scheduler.service();
+    }
+}
+
+// --------------------------------------------------------------------------
+// Hardware-scrolled canvas: a news ticker over a trend graph, far wider than the display. Each
+// step uploads only the newly exposed column and lets the display scroll it into view.
+// --------------------------------------------------------------------------
+void example_scroll_canvas(FutabaNAGP1250& vfd) {
+    static const char message[] = "+++ Hardware scrolling: each step sends one new column, not a frame +++   ";
+
+    FutabaNAGP1250ScrollCanvas canvas(vfd, [](FutabaNAGP1250Framebuffer& strip, uint32_t x, void*) {
+        // Ticker: the 5x7 font advances 6 columns per character, so start at the first
+        // character that reaches into the strip.
+        static FutabaNAGP1250TextRenderer text;
+        const uint32_t length = sizeof(message) - 1;
+        int16_t pen = -static_cast<int16_t>(x % 6);
+        for (uint32_t i = x / 6; pen < static_cast<int16_t>(strip.width()); ++i) {
+            pen = text.drawChar(strip, pen, 4, message[i % length]);
+        }
+
+        // Trend graph: one sample per column, joined to the previous one.
+        auto sample = [](uint32_t column) {
+            return static_cast<int16_t>(24 + 5 * sin(column * 0.07f) + (column * 37 % 11 == 0 ? -2 : 0));
+        };
+        for (uint16_t i = 0; i < strip.width(); ++i) {
+            const int16_t from = sample(x + i - 1);
+            const int16_t to = sample(x + i);
+            for (int16_t y = min(from, to); y <= max(from, to); ++y) {
+                strip.setPixel(i, y);
+            }
+        }
+    });
+
+    canvas.begin();
+    for (uint16_t step = 0; step < 600; ++step) {
+        canvas.scroll(1);
+        delay(15);
+    }
+
+    // Initializing resets the display scroll and the base window for the next example.
+    vfd.begin(FutabaNAGP1250::BASE_WINDOW_MODE_DEFAULT, 4, 0);
+}
+
+// --------------------------------------------------------------------------
+// Strip rendering: a rotating radar sweep drawn without a frame buffer. The scene is rendered
+// 16 columns at a time into 64 bytes and streamed as one bit image, which fits an Uno.
+// --------------------------------------------------------------------------
+void example_strip_rendering(FutabaNAGP1250& vfd) {
+    float sweep = 0;
+    FutabaNAGP1250StripRenderer strips(vfd, [](FutabaNAGP1250Framebuffer& strip, void* context) {
+        static FutabaNAGP1250TextRenderer text;
+        const float angle = *static_cast<const float*>(context);
+        FutabaNAGP1250::drawGraphicCircle(strip, 70, 16, 15);
+        FutabaNAGP1250::drawGraphicCircle(strip, 70, 16, 8);
+        FutabaNAGP1250::drawGraphicLines(strip, {{70, 16, angle, 15}, {70, 16, angle - 4, 15}});
+        FutabaNAGP1250::drawGraphicBox(strip, 0, 0, 44, 32, 4);
+        FutabaNAGP1250::drawGraphicBox(strip, 96, 0, 44, 32, 4);
+        text.drawText(strip, 8, 12, "RADAR");
+        text.drawText(strip, 104, 12, "STRIP");
+    }, &sweep, 16);
+
+    for (; sweep < 720; sweep += 6) {
+        strips.draw();
+    }
+}
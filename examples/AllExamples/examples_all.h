@@ -12,4 +12,8 @@ void example_graphics_and_text(FutabaNAGP1250& vfd);
 void example_graphics_text_boxes(FutabaNAGP1250& vfd);
 void example_graphics_text_dynamic_windows(FutabaNAGP1250& vfd);
 void example_multiple_graphics_logical_or(FutabaNAGP1250& vfd);
+void example_framebuffer_text(FutabaNAGP1250& vfd);
+void example_sprites(FutabaNAGP1250& vfd);
+void example_scroll_canvas(FutabaNAGP1250& vfd);
+void example_strip_rendering(FutabaNAGP1250& vfd);
 
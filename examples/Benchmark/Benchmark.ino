@@ -0,0 +1,403 @@
+#include <Arduino.h>
+#include <SPI.h>
+
+#include "FutabaNAGP1250.h"
+
+// VSPI defaults on ESP32 dev kits.
+// Adjust these pins for your specific board!
+#ifdef ESP32
+constexpr int PIN_MOSI = 23;
+constexpr int PIN_SCK = 18;
+constexpr int PIN_RESET = 5;
+constexpr int PIN_SBUSY = 35; // Set to -1 if not connected
+#else
+// Example for generic Arduino (Uno/Nano)
+constexpr int PIN_MOSI = 11;
+constexpr int PIN_SCK = 13;
+constexpr int PIN_RESET = 9;
+constexpr int PIN_SBUSY = 8; // Pin 2 or 3 enables the interrupt-driven measurement
+#endif
+
+constexpr int FRAMES = 50;
+constexpr int FRAMES_NO_SBUSY = 5; // ~0.25 s per frame with the fixed byte delay
+
+FutabaNAGP1250 vfd(SPI, PIN_RESET, PIN_SBUSY);
+// The same display driven as if SBUSY were not wired: fixed spacing after every byte instead of
+// flow control. It shares the SPI bus (and the display state) set up by `vfd`.
+FutabaNAGP1250SpiTimedTransport timedTransport(FutabaNAGP1250SpiBus(SPI, 115200), FutabaNAGP1250TimedFlow());
+FutabaNAGP1250 vfdTimed(timedTransport);
+FutabaNAGP1250Framebuffer frame(140, 32);
+
+// Stand-in for application work: each call is one unit of fixed cost.
+static volatile uint32_t spareUnits = 0;
+static volatile uint32_t spareScratch = 1;
+static void spareWork() {
+    for (uint8_t i = 0; i < 32; ++i) {
+        spareScratch = spareScratch * 1664525UL + 1013904223UL;
+    }
+    ++spareUnits;
+}
+
+// SBUSY on an edge interrupt: while the display is busy the transmitter runs spareWork() instead
+// of spinning. On a pin without an external interrupt it falls back to polling.
+FutabaNAGP1250SpiSbusyIrqTransport irqTransport(FutabaNAGP1250SpiBus(SPI, 115200),
+                                                FutabaNAGP1250SbusyIrqFlow(PIN_SBUSY, spareWork));
+FutabaNAGP1250 vfdIrq(irqTransport);
+
+// Link counters of the last measurement; only filled in when built with FUTABA_NAGP1250_STATS=1.
+static void printLinkStats(const FutabaNAGP1250& display) {
+    if (!FutabaNAGP1250::statsEnabled()) {
+        return;
+    }
+    const FutabaNAGP1250Stats& stats = display.stats();
+    Serial.print(F("  "));
+    Serial.print(stats.transactions);
+    Serial.print(F(" transactions, "));
+    Serial.print(stats.stalls);
+    Serial.print(F(" stalls ("));
+    Serial.print(stats.stallUs);
+    Serial.print(F(" us, max "));
+    Serial.print(stats.maxStallUs);
+    Serial.print(F(" us), delays "));
+    Serial.print(stats.delayUs);
+    Serial.print(F(" us, timeouts "));
+    Serial.println(stats.timeouts);
+    Serial.print(F("  stall histogram:"));
+    for (uint8_t i = 0; i < FutabaNAGP1250Stats::STALL_BUCKETS; ++i) {
+        Serial.print(' ');
+        Serial.print(stats.stallHistogram[i]);
+    }
+    Serial.println();
+}
+
+// Streams `frames` full frames and prints the sustained throughput.
+static void benchmarkFullFrames(FutabaNAGP1250& display, const char* label, int frames) {
+    const uint32_t frameBytes = frame.size() + 9; // bit image header + payload
+
+    display.resetStats();
+    const uint32_t start = micros();
+    for (int i = 0; i < frames; ++i) {
+        frame.clear();
+        FutabaNAGP1250::drawGraphicCircle(frame, (i * 3) % 140, 16, 10);
+        display.displayGraphicImage(frame);
+    }
+    const uint32_t elapsed = micros() - start;
+
+    Serial.print(label);
+    Serial.print(F(": "));
+    Serial.print(frames * 1000000.0f / elapsed, 1);
+    Serial.print(F(" FPS, "));
+    Serial.print(static_cast<uint32_t>(frames * frameBytes * 1000000.0f / elapsed));
+    Serial.println(F(" bytes/s"));
+    printLinkStats(display);
+}
+
+static void printCpuLoad(const __FlashStringHelper* label, uint32_t elapsed, uint32_t units, float usPerUnit) {
+    const float load = 100.0f * (1.0f - min(units * usPerUnit / elapsed, 1.0f));
+    Serial.print(label);
+    Serial.print(elapsed);
+    Serial.print(F(" us per frame, CPU load "));
+    Serial.print(load, 0);
+    Serial.println(F(" %"));
+}
+
+// CPU load during one full-frame upload: the application work that still gets done while the
+// frame is on its way, compared with how fast that work runs on an otherwise idle CPU.
+static void benchmarkCpuLoad() {
+    constexpr uint16_t BASELINE_UNITS = 2000;
+    spareUnits = 0;
+    uint32_t start = micros();
+    while (spareUnits < BASELINE_UNITS) {
+        spareWork();
+    }
+    const float usPerUnit = static_cast<float>(micros() - start) / BASELINE_UNITS;
+
+    // Spinning on SBUSY: nothing else runs until the frame is out.
+    start = micros();
+    vfd.displayGraphicImage(frame);
+    printCpuLoad(F("Blocking, SBUSY polling: "), micros() - start, 0, usPerUnit);
+
+    // Blocking call on the interrupt flow: the waits run the idle hook.
+    spareUnits = 0;
+    start = micros();
+    vfdIrq.displayGraphicImage(frame);
+    printCpuLoad(F("Blocking, SBUSY interrupt: "), micros() - start, spareUnits, usPerUnit);
+
+    // Asynchronous upload polled from the loop between units of work.
+    spareUnits = 0;
+    start = micros();
+    vfd.displayGraphicImageAsync(frame);
+    while (vfd.service()) {
+        spareWork();
+    }
+    printCpuLoad(F("Async, polled from loop: "), micros() - start, spareUnits, usPerUnit);
+
+#if !defined(ESP32) && !defined(ESP8266)
+    // Asynchronous upload resumed by the SBUSY edge; the loop only does its own work.
+    vfdIrq.setServiceFromInterrupt(true);
+    spareUnits = 0;
+    start = micros();
+    vfdIrq.displayGraphicImageAsync(frame);
+    while (vfdIrq.isFrameInFlight()) {
+        spareWork();
+    }
+    printCpuLoad(F("Async, resumed by interrupt: "), micros() - start, spareUnits, usPerUnit);
+    vfdIrq.setServiceFromInterrupt(false);
+#endif
+}
+
+// A typical overlay update: switch write logic, move the cursor, print, restore.
+static void overlayUpdate() {
+    vfd.setWriteLogic(FutabaNAGP1250::WRITE_MODE_XOR);
+    vfd.setCursorPosition(75, 1);
+    vfd.writeText("XOR");
+    vfd.setWriteLogic(FutabaNAGP1250::WRITE_MODE_NORMAL);
+}
+
+static void benchmarkOverlayUpdates() {
+    constexpr int UPDATES = 100;
+
+    uint32_t start = micros();
+    for (int i = 0; i < UPDATES; ++i) {
+        overlayUpdate();
+    }
+    const uint32_t separate = (micros() - start) / UPDATES;
+
+    start = micros();
+    for (int i = 0; i < UPDATES; ++i) {
+        FutabaNAGP1250::Batch batch(vfd);
+        overlayUpdate();
+    }
+    const uint32_t batched = (micros() - start) / UPDATES;
+
+    Serial.print(F("Overlay update, separate transactions: "));
+    Serial.print(separate);
+    Serial.println(F(" us"));
+    Serial.print(F("Overlay update, one batch: "));
+    Serial.print(batched);
+    Serial.println(F(" us"));
+}
+
+// The per-pixel packer packBitmap() used before the 8x8 transpose kernel, kept for comparison.
+static void packBitmapPerPixel(const uint8_t* bitmap, uint16_t width, uint16_t height, uint8_t* out) {
+    for (uint16_t x = 0; x < width; ++x) {
+        for (uint16_t row = 0; row < height; row += 8) {
+            uint8_t byte = 0;
+            for (uint8_t bit = 0; bit < 8 && (row + bit) < height; ++bit) {
+                if (bitmap[(row + bit) * width + x]) {
+                    byte |= (1 << (7 - bit));
+                }
+            }
+            *out++ = byte;
+        }
+    }
+}
+
+static void printPixelRate(const __FlashStringHelper* label, uint32_t elapsed, uint32_t pixels) {
+    Serial.print(label);
+    Serial.print(pixels * 1000.0f / elapsed, 0);
+    Serial.println(F(" kpx/s"));
+}
+
+static void benchmarkPacking() {
+    constexpr uint16_t W = 140;
+#ifdef __AVR__
+    constexpr uint16_t H = 8;  // one band: a byte-per-pixel 140x32 frame alone takes 4480 bytes
+#else
+    constexpr uint16_t H = 32;
+#endif
+    constexpr int ROUNDS = 20;
+    // On the stack, so the inputs only take RAM while this benchmark runs.
+    uint8_t pixels[W * H];
+    uint8_t bits[(W + 7) / 8 * H];
+    for (uint16_t i = 0; i < W * H; ++i) {
+        pixels[i] = (i * 7 + i / W) % 3 == 0;
+    }
+    for (uint16_t i = 0; i < sizeof(bits); ++i) {
+        bits[i] = static_cast<uint8_t>(i * 37);
+    }
+
+    uint32_t start = micros();
+    for (int i = 0; i < ROUNDS; ++i) {
+        packBitmapPerPixel(pixels, W, H, frame.data());
+    }
+    printPixelRate(F("Per-pixel packer: "), micros() - start, ROUNDS * W * H);
+
+    start = micros();
+    for (int i = 0; i < ROUNDS; ++i) {
+        FutabaNAGP1250::packBitmap(pixels, W, H, frame.data());
+    }
+    printPixelRate(F("packBitmap (8x8 transpose): "), micros() - start, ROUNDS * W * H);
+
+    start = micros();
+    for (int i = 0; i < ROUNDS; ++i) {
+        FutabaNAGP1250::packBitmap1bpp(bits, W, H, frame.data());
+    }
+    printPixelRate(F("packBitmap1bpp: "), micros() - start, ROUNDS * W * H);
+}
+
+static void printLineRate(const __FlashStringHelper* label, uint32_t elapsed, uint32_t lines) {
+    Serial.print(label);
+    Serial.print(lines * 1000000.0f / elapsed, 0);
+    Serial.println(F(" lines/s"));
+}
+
+// Radial gauge needles (angle/length form), arbitrary end points and axis-aligned lines.
+static void benchmarkLines() {
+    constexpr int LINES = 360;
+
+    frame.clear();
+    uint32_t start = micros();
+    for (int i = 0; i < LINES; ++i) {
+        FutabaNAGP1250::drawGraphicLines(frame, {{70, 16, static_cast<float>(i), 15}});
+    }
+    printLineRate(F("Radial lines: "), micros() - start, LINES);
+
+    frame.clear();
+    start = micros();
+    for (int i = 0; i < LINES; ++i) {
+        FutabaNAGP1250::drawGraphicLine(frame, i % 140, 0, 139 - i % 140, 31);
+    }
+    printLineRate(F("End point lines: "), micros() - start, LINES);
+
+    frame.clear();
+    start = micros();
+    for (int i = 0; i < LINES; ++i) {
+        FutabaNAGP1250::drawGraphicLine(frame, 0, i % 32, 139, i % 32);
+        FutabaNAGP1250::drawGraphicLine(frame, i % 140, 0, i % 140, 31);
+    }
+    printLineRate(F("Horizontal + vertical lines: "), micros() - start, 2 * LINES);
+}
+
+static void printShapeTime(const __FlashStringHelper* label, uint32_t elapsed, uint32_t shapes) {
+    Serial.print(label);
+    Serial.print(static_cast<float>(elapsed) / shapes, 1);
+    Serial.println(F(" us"));
+}
+
+// Filled shapes against a plain fill() of the whole framebuffer.
+static void benchmarkShapes() {
+    constexpr int ROUNDS = 100;
+
+    uint32_t start = micros();
+    for (int i = 0; i < ROUNDS; ++i) {
+        frame.fill(i & 1);
+    }
+    printShapeTime(F("fill(): "), micros() - start, ROUNDS);
+
+    start = micros();
+    for (int i = 0; i < ROUNDS; ++i) {
+        FutabaNAGP1250::drawGraphicBox(frame, 0, 0, 140, 32, 0, true);
+    }
+    printShapeTime(F("Full-screen filled box: "), micros() - start, ROUNDS);
+
+    start = micros();
+    for (int i = 0; i < ROUNDS; ++i) {
+        frame.clear();
+        FutabaNAGP1250::drawGraphicBox(frame, 10, 10, 120, 12, 0, false);
+        frame.fillRect(12, 12, i % 117, 8);
+    }
+    printShapeTime(F("Progress bar (clear + outline + bar): "), micros() - start, ROUNDS);
+
+    start = micros();
+    for (int i = 0; i < ROUNDS; ++i) {
+        FutabaNAGP1250::drawGraphicBox(frame, 4, 2, 132, 28, 8, true);
+    }
+    printShapeTime(F("Rounded filled box: "), micros() - start, ROUNDS);
+
+    start = micros();
+    for (int i = 0; i < ROUNDS; ++i) {
+        FutabaNAGP1250::drawGraphicCircleFilled(frame, 70, 16, 15);
+    }
+    printShapeTime(F("Filled circle r=15: "), micros() - start, ROUNDS);
+}
+
+static void discardBand(const uint8_t*, uint16_t, uint8_t, void*) {}
+
+// Grayscale rows dithered into packed bands; only the dither pipeline is timed.
+static void benchmarkDither(uint16_t width) {
+    constexpr int FRAMES_DITHERED = 20;
+    FutabaNAGP1250Dither dither(width);
+    uint8_t gray[FutabaNAGP1250Framebuffer::MAX_WIDTH];
+    for (uint16_t x = 0; x < sizeof(gray); ++x) {
+        gray[x] = static_cast<uint8_t>(x * 7);
+    }
+
+    const FutabaNAGP1250Dither::Mode modes[] = {
+        FutabaNAGP1250Dither::MODE_THRESHOLD,
+        FutabaNAGP1250Dither::MODE_BAYER,
+        FutabaNAGP1250Dither::MODE_FLOYD_STEINBERG,
+    };
+    const char* const names[] = {"threshold", "Bayer", "Floyd-Steinberg"};
+
+    for (uint8_t m = 0; m < 3; ++m) {
+        dither.setMode(modes[m]);
+        const uint32_t start = micros();
+        for (int i = 0; i < FRAMES_DITHERED; ++i) {
+            dither.begin(discardBand);
+            for (uint8_t y = 0; y < 32; ++y) {
+                dither.writeRow(gray);
+            }
+        }
+        const uint32_t elapsed = micros() - start;
+
+        Serial.print(width);
+        Serial.print(F("x32 "));
+        Serial.print(names[m]);
+        Serial.print(F(": "));
+        Serial.print(FRAMES_DITHERED * 1000000.0f / elapsed, 1);
+        Serial.println(F(" FPS"));
+    }
+}
+
+void setup() {
+    Serial.begin(115200);
+    while (!Serial) {
+        delay(10);
+    }
+
+    #ifdef ESP32
+    SPI.begin(PIN_SCK, -1, PIN_MOSI, -1);
+    #else
+    SPI.begin();
+    #endif
+
+    vfd.begin(FutabaNAGP1250::BASE_WINDOW_MODE_DEFAULT, 4, 0);
+    vfd.setWriteLogic(FutabaNAGP1250::WRITE_MODE_NORMAL);
+    irqTransport.begin();
+}
+
+void loop() {
+    Serial.println(F("--- Full-frame streaming ---"));
+
+    vfd.setBurstLimit(1);
+    benchmarkFullFrames(vfd, "SBUSY, per-byte polling", FRAMES);
+
+    vfd.setBurstLimit(32);
+    benchmarkFullFrames(vfd, "SBUSY, adaptive burst", FRAMES);
+    Serial.print(F("Settled burst size: "));
+    Serial.println(vfd.burstSize());
+
+    benchmarkFullFrames(vfdTimed, "No SBUSY, 400us byte delay", FRAMES_NO_SBUSY);
+
+    Serial.println(F("--- CPU load during upload ---"));
+    benchmarkCpuLoad();
+
+    Serial.println(F("--- Command batching ---"));
+    benchmarkOverlayUpdates();
+
+    Serial.println(F("--- Bitmap packing ---"));
+    benchmarkPacking();
+
+    Serial.println(F("--- Line drawing ---"));
+    benchmarkLines();
+
+    Serial.println(F("--- Filled shapes ---"));
+    benchmarkShapes();
+
+    Serial.println(F("--- Grayscale dithering ---"));
+    benchmarkDither(140);
+    benchmarkDither(256);
+
+    delay(5000);
+}
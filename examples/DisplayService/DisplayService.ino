@@ -0,0 +1,131 @@
+#include <Arduino.h>
+#include <SPI.h>
+
+#include "FutabaNAGP1250.h"
+#include "FutabaNAGP1250DisplayService.h"
+
+// Several tasks updating one display through FutabaNAGP1250DisplayService: the display task owns
+// the driver, the others only encode commands and post them. On ESP32 every producer is its own
+// FreeRTOS task; elsewhere they take turns in loop().
+
+#ifdef ESP32
+constexpr int PIN_MOSI = 23;
+constexpr int PIN_SCK = 18;
+constexpr int PIN_RESET = 5;
+constexpr int PIN_SBUSY = 35;
+#else
+constexpr int PIN_RESET = 9;
+constexpr int PIN_SBUSY = 8;
+#endif
+
+FutabaNAGP1250 vfd(SPI, PIN_RESET, PIN_SBUSY);
+
+#if FUTABA_NAGP1250_HAS_ATOMIC
+
+FutabaNAGP1250DisplayService service(vfd);
+
+// Top line: uptime.
+static void postStatus(FutabaNAGP1250DisplayService::Producer& producer) {
+    char text[24];
+    snprintf(text, sizeof(text), "Up %lus   ", millis() / 1000);
+    producer.display().setCursorPosition(0, 0);
+    producer.display().writeText(text);
+    producer.post();
+}
+
+// Second line: a fake sensor reading.
+static void postSensor(FutabaNAGP1250DisplayService::Producer& producer) {
+    char text[24];
+    snprintf(text, sizeof(text), "Temp %2ld.%ld C  ", 20 + random(5), random(10));
+    producer.display().setCursorPosition(0, 1);
+    producer.display().writeText(text);
+    producer.post();
+}
+
+// Bottom right: a bar that fills up, drawn into a small framebuffer and posted as an image.
+// The image is not copied into the queue, so the bar is only redrawn once the display task has
+// sent the previous one.
+static std::atomic<bool> barSent(true);
+
+static void postBar(FutabaNAGP1250DisplayService::Producer& producer, FutabaNAGP1250Framebuffer& bar) {
+    static uint8_t level = 0;
+    if (!barSent.load()) {
+        return;
+    }
+    level = (level + 1) % 41;
+    bar.clear();
+    FutabaNAGP1250::drawGraphicBox(bar, 0, 0, 40, 8);
+    bar.fillRect(0, 0, level, 8);
+    barSent.store(false);
+    producer.display().setCursorPosition(100, 3);
+    producer.postImage(bar, [](void*) { barSent.store(true); });
+}
+
+#ifdef ESP32
+template <void (*Post)(FutabaNAGP1250DisplayService::Producer&), uint32_t PeriodMs>
+static void producerTask(void*) {
+    FutabaNAGP1250DisplayService::Producer producer(service);
+    for (;;) {
+        Post(producer);
+        vTaskDelay(pdMS_TO_TICKS(PeriodMs));
+    }
+}
+
+static void barTask(void*) {
+    FutabaNAGP1250DisplayService::Producer producer(service);
+    FutabaNAGP1250Framebuffer bar(40, 8);
+    for (;;) {
+        postBar(producer, bar);
+        vTaskDelay(pdMS_TO_TICKS(50));
+    }
+}
+#endif
+
+void setup() {
+    Serial.begin(115200);
+#ifdef ESP32
+    SPI.begin(PIN_SCK, -1, PIN_MOSI, -1);
+#else
+    SPI.begin();
+#endif
+    vfd.begin();
+
+#ifdef ESP32
+    xTaskCreate(producerTask<postStatus, 1000>, "status", 4096, nullptr, 1, nullptr);
+    xTaskCreate(producerTask<postSensor, 250>, "sensor", 4096, nullptr, 1, nullptr);
+    xTaskCreate(barTask, "bar", 4096, nullptr, 1, nullptr);
+#endif
+}
+
+void loop() {
+#ifndef ESP32
+    static FutabaNAGP1250DisplayService::Producer status(service);
+    static FutabaNAGP1250DisplayService::Producer sensor(service);
+    static FutabaNAGP1250DisplayService::Producer bars(service);
+    static FutabaNAGP1250Framebuffer bar(40, 8);
+    static uint32_t tick = 0;
+    if (tick % 20 == 0) postStatus(status);
+    if (tick % 5 == 0) postSensor(sensor);
+    postBar(bars, bar);
+    ++tick;
+    delay(50);
+#endif
+    // The display task: everything posted since the last call goes out in one batch.
+    service.process();
+    static uint32_t rejected = 0;
+    if (service.rejected() != rejected) {
+        rejected = service.rejected();
+        Serial.println(F("Display queue overflow"));
+    }
+}
+
+#else
+
+void setup() {
+    Serial.begin(115200);
+    Serial.println(F("FutabaNAGP1250DisplayService needs <atomic>, which this core does not provide."));
+}
+
+void loop() {}
+
+#endif
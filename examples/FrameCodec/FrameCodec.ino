@@ -0,0 +1,119 @@
+#include <Arduino.h>
+#include <SPI.h>
+
+#include "FutabaNAGP1250.h"
+
+// Encodes the animations from the AllExamples sketch, checks that the decoder reproduces every
+// frame and reports the compression ratio against raw 560 byte frames. The decoded stream is
+// also played on the display without a framebuffer (delta frames are applied with XOR logic).
+// Needs about 2.5 KB of RAM for the frame buffers, so use an ESP32 or similar.
+
+// VSPI defaults on ESP32 dev kits.
+// Adjust these pins for your specific board!
+#ifdef ESP32
+constexpr int PIN_MOSI = 23;
+constexpr int PIN_SCK = 18;
+constexpr int PIN_RESET = 5;
+constexpr int PIN_SBUSY = 35; // Set to -1 if not connected
+#else
+// Example for generic Arduino (Uno/Nano)
+constexpr int PIN_MOSI = 11;
+constexpr int PIN_SCK = 13;
+constexpr int PIN_RESET = 9;
+constexpr int PIN_SBUSY = 8;
+#endif
+
+FutabaNAGP1250 vfd(SPI, PIN_RESET, PIN_SBUSY);
+FutabaNAGP1250Framebuffer frame(140, 32);
+FutabaNAGP1250Framebuffer decoded(140, 32);
+FutabaNAGP1250FrameEncoder encoder(140, 4);
+FutabaNAGP1250FrameDecoder frameDecoder;
+FutabaNAGP1250FrameDecoder displayDecoder;
+uint8_t encoded[570]; // FutabaNAGP1250FrameEncoder::maxEncodedSize(140, 4)
+
+typedef void (*RenderFrame)(FutabaNAGP1250Framebuffer& frame, int index);
+
+static void circleFilling(FutabaNAGP1250Framebuffer& f, int i) {
+    FutabaNAGP1250::drawGraphicLines(f, {{70, 16, static_cast<float>(i * 5 % 360), 10}});
+}
+
+static void pixelBlocks(FutabaNAGP1250Framebuffer& f, int i) {
+    const int blockSize = 1 << (i / 5 % 3);
+    for (int y = 0; y < f.height(); y += blockSize) {
+        for (int x = 0; x < f.width(); x += blockSize) {
+            f.fillRect(x, y, blockSize, blockSize, random(2));
+        }
+    }
+}
+
+static void radialLines(FutabaNAGP1250Framebuffer& f, int i) {
+    f.clear();
+    FutabaNAGP1250::drawGraphicLines(f, {{70, 16, static_cast<float>(i * 5 % 360), 30}});
+}
+
+static void waveforms(FutabaNAGP1250Framebuffer& f, int i) {
+    f.clear();
+    for (int x = 0; x < f.width(); ++x) {
+        f.setPixel(x, 16 + static_cast<int>(10 * sin((x * 0.1) + i * 0.2f)));
+    }
+}
+
+static void runAnimation(const char* name, RenderFrame render, int frames) {
+    frame.clear();
+    encoder.reset();
+    uint32_t encodedBytes = 0;
+    uint16_t mismatches = 0;
+
+    for (int i = 0; i < frames; ++i) {
+        render(frame, i);
+        const size_t length = encoder.encode(frame, encoded, sizeof(encoded));
+        encodedBytes += length;
+
+        frameDecoder.write(encoded, length);
+        if (memcmp(frame.data(), decoded.data(), frame.size()) != 0) {
+            ++mismatches;
+        }
+        // Feed the display in small pieces, as if the bytes arrived over a serial link.
+        for (size_t offset = 0; offset < length; offset += 16) {
+            displayDecoder.write(encoded + offset, min(static_cast<size_t>(16), length - offset));
+        }
+    }
+
+    const uint32_t rawBytes = static_cast<uint32_t>(frames) * frame.size();
+    Serial.print(name);
+    Serial.print(F(": "));
+    Serial.print(encodedBytes);
+    Serial.print(F(" / "));
+    Serial.print(rawBytes);
+    Serial.print(F(" bytes, ratio "));
+    Serial.print(static_cast<float>(encodedBytes) / rawBytes, 3);
+    Serial.print(F(", mismatches "));
+    Serial.println(mismatches);
+}
+
+void setup() {
+    Serial.begin(115200);
+    while (!Serial) {
+        delay(10);
+    }
+
+    #ifdef ESP32
+    SPI.begin(PIN_SCK, -1, PIN_MOSI, -1);
+    #else
+    SPI.begin();
+    #endif
+
+    vfd.begin(FutabaNAGP1250::BASE_WINDOW_MODE_DEFAULT, 4, 0);
+    vfd.setWriteLogic(FutabaNAGP1250::WRITE_MODE_NORMAL);
+    frameDecoder.begin(decoded);
+    displayDecoder.begin(vfd);
+}
+
+void loop() {
+    vfd.setCursorPosition(0, 0);
+    runAnimation("Animated circle filling", circleFilling, 72);
+    runAnimation("Animated pixel blocks", pixelBlocks, 50);
+    runAnimation("Animated radial lines", radialLines, 72);
+    runAnimation("Animated waveforms", waveforms, 100);
+    delay(5000);
+}
@@ -0,0 +1,89 @@
+#include <Arduino.h>
+#include <SPI.h>
+
+#include "FutabaNAGP1250.h"
+
+// Four gray levels by bit-plane PWM: a level ramp and a gauge whose needle edges use the
+// middle levels. The achieved refresh rate is printed once a second.
+
+// VSPI defaults on ESP32 dev kits.
+// Adjust these pins for your specific board!
+#ifdef ESP32
+constexpr int PIN_MOSI = 23;
+constexpr int PIN_SCK = 18;
+constexpr int PIN_RESET = 5;
+constexpr int PIN_SBUSY = 35; // Set to -1 if not connected
+#else
+// Example for generic Arduino (Uno/Nano)
+constexpr int PIN_MOSI = 11;
+constexpr int PIN_SCK = 13;
+constexpr int PIN_RESET = 9;
+constexpr int PIN_SBUSY = 8;
+#endif
+
+FutabaNAGP1250 vfd(SPI, PIN_RESET, PIN_SBUSY);
+FutabaNAGP1250GrayCanvas canvas(140, 32, 2);
+FutabaNAGP1250GrayScheduler scheduler(vfd, canvas);
+
+static void drawScene(float needleDeg) {
+    canvas.clear();
+    for (uint8_t level = 0; level < canvas.levels(); ++level) {
+        canvas.fillRect(level * 12, 0, 12, 32, level);
+    }
+
+    // Needle drawn three times: dim halo on both sides, full brightness in the middle.
+    const float rad = needleDeg * DEG_TO_RAD;
+    const int16_t ox = static_cast<int16_t>(roundf(sinf(rad)));
+    const int16_t oy = static_cast<int16_t>(roundf(cosf(rad)));
+    for (int8_t side = -1; side <= 1; side += 2) {
+        for (uint8_t i = 0; i < 28; ++i) {
+            canvas.setPixel(95 + ox * side + static_cast<int16_t>(roundf(cosf(rad) * i)),
+                            30 + oy * side - static_cast<int16_t>(roundf(sinf(rad) * i)), 1);
+        }
+    }
+    for (uint8_t i = 0; i < 28; ++i) {
+        canvas.setPixel(95 + static_cast<int16_t>(roundf(cosf(rad) * i)),
+                        30 - static_cast<int16_t>(roundf(sinf(rad) * i)), canvas.levels() - 1);
+    }
+}
+
+void setup() {
+    Serial.begin(115200);
+    while (!Serial) {
+        delay(10);
+    }
+
+    #ifdef ESP32
+    SPI.begin(PIN_SCK, -1, PIN_MOSI, -1);
+    #else
+    SPI.begin();
+    #endif
+
+    vfd.begin(FutabaNAGP1250::BASE_WINDOW_MODE_DEFAULT, 4, 0);
+    vfd.setWriteLogic(FutabaNAGP1250::WRITE_MODE_NORMAL);
+    vfd.setBurstLimit(32);
+}
+
+void loop() {
+    static uint32_t lastScene = 0;
+    static uint32_t lastReport = 0;
+    static float needle = 0;
+
+    if (millis() - lastScene >= 50) {
+        lastScene = millis();
+        needle = needle >= 180 ? 0 : needle + 2;
+        drawScene(needle);
+    }
+
+    scheduler.service();
+
+    if (millis() - lastReport >= 1000) {
+        lastReport = millis();
+        Serial.print(F("Refresh "));
+        Serial.print(scheduler.refreshRate(), 1);
+        Serial.print(F(" Hz, slot "));
+        Serial.print(scheduler.slotTime());
+        Serial.print(F(" us, "));
+        Serial.println(scheduler.flickerFree() ? F("flicker-free") : F("below flicker threshold"));
+    }
+}
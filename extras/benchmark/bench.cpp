@@ -0,0 +1,508 @@
+// Host benchmark for the library's rendering and transport hot paths.
+//
+// Builds on Linux against the stubs in ./stubs (see the Makefile) and prints one line per case:
+// host CPU time per operation and heap allocations per operation. The transport cases also
+// report the frame rate and byte rate the modelled display link would sustain, and the
+// contention cases compare several producer threads sharing one display through the lock-free
+// display service with the same producers sharing the driver under a mutex. Compare the
+// output between releases to catch regressions:
+//
+//     make run > before.txt      (old release)
+//     make run > after.txt       (new release)
+//     diff before.txt after.txt
+//
+// An optional argument only runs the cases whose name contains it, e.g. `./bench circle`.
+//
+// The command encoding cases (encoding, flush and dirty-region flush included) must not touch the
+// heap once warmed up; if one of them does, it is reported and the benchmark exits with status 1.
+
+#include <FutabaNAGP1250.h>
+#include <FutabaNAGP1250DisplayService.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <new>
+#include <thread>
+
+namespace {
+
+// ---------------------------------------------------------------------------------------
+// Allocation counting
+// ---------------------------------------------------------------------------------------
+
+std::atomic<uint64_t> allocations(0);
+
+// ---------------------------------------------------------------------------------------
+// Timing harness
+// ---------------------------------------------------------------------------------------
+
+constexpr double MIN_SECONDS = 0.2;
+const char* filter = nullptr;
+int failures = 0;
+
+volatile uint32_t sink;
+
+// Returns the heap allocations made by all timed iterations.
+template <typename Fn>
+uint64_t run(const char* name, Fn fn, const char* note = "") {
+    if (filter && !strstr(name, filter)) {
+        return 0;
+    }
+    using Clock = std::chrono::steady_clock;
+    fn(); // warm-up
+
+    uint64_t iterations = 1;
+    double seconds = 0;
+    uint64_t allocated = 0;
+    for (;;) {
+        const uint64_t allocationsBefore = allocations.load();
+        const Clock::time_point start = Clock::now();
+        for (uint64_t i = 0; i < iterations; ++i) {
+            fn();
+        }
+        seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        allocated = allocations.load() - allocationsBefore;
+        if (seconds >= MIN_SECONDS) {
+            break;
+        }
+        iterations *= seconds > 0 ? min(max(MIN_SECONDS * 1.2 / seconds, 2.0), 100.0) : 100.0;
+    }
+    printf("%-40s %12.1f ns/op %8.2f allocs/op  %s\n", name, seconds * 1e9 / iterations,
+           static_cast<double>(allocated) / iterations, note);
+    return allocated;
+}
+
+// Same as run() for cases that must not allocate; counts a failure if one does.
+template <typename Fn>
+void runWithoutAllocations(const char* name, Fn fn, const char* note = "") {
+    if (run(name, fn, note)) {
+        printf("FAIL: %s allocated on the heap\n", name);
+        ++failures;
+    }
+}
+
+void section(const char* title) {
+    if (!filter) {
+        printf("\n--- %s ---\n", title);
+    }
+}
+
+// ---------------------------------------------------------------------------------------
+// Transports
+// ---------------------------------------------------------------------------------------
+
+// Accepts everything immediately; isolates the driver's own encoding cost.
+class NullTransport : public FutabaNAGP1250Transport {
+public:
+    using FutabaNAGP1250Transport::write;
+    void write(const uint8_t* data, size_t blocks, size_t blockLength, size_t stride) override {
+        bytes += blocks * blockLength;
+        sink = data[(blocks - 1) * stride + blockLength - 1];
+    }
+    size_t writeAvailable(const uint8_t*, size_t length) override {
+        bytes += length;
+        return length;
+    }
+    bool busy() override { return false; }
+    bool waitIdle(uint32_t) override { return true; }
+
+    uint64_t bytes = 0;
+};
+
+// Bytes one call of `fn` puts on the wire.
+template <typename Fn>
+uint64_t wireBytes(NullTransport& transport, Fn fn) {
+    const uint64_t before = transport.bytes;
+    fn();
+    return transport.bytes - before;
+}
+
+constexpr uint16_t WIDTH = 140;
+constexpr uint16_t HEIGHT = 32;
+constexpr uint32_t SPI_FREQUENCY = 1000000;
+constexpr uint16_t NO_SBUSY_BYTE_DELAY_US = 400; // FutabaNAGP1250TimedFlow default
+
+void benchmarkPacking() {
+    section("Bitmap packing (140x32)");
+
+    static uint8_t bitmap[WIDTH * HEIGHT];
+    static uint8_t bits[(WIDTH + 7) / 8 * HEIGHT];
+    static uint8_t packed[WIDTH * HEIGHT / 8];
+    for (size_t i = 0; i < sizeof(bitmap); ++i) {
+        bitmap[i] = (i * 2654435761u) >> 31;
+    }
+    for (size_t i = 0; i < sizeof(bits); ++i) {
+        bits[i] = static_cast<uint8_t>(i * 37);
+    }
+    std::vector<uint8_t> bitmapVector(bitmap, bitmap + sizeof(bitmap));
+
+    run("packBitmap (byte per pixel)", [&] {
+        FutabaNAGP1250::packBitmap(bitmap, WIDTH, HEIGHT, packed);
+        sink = packed[0];
+    });
+    run("packBitmap1bpp (row-major bits)", [&] {
+        FutabaNAGP1250::packBitmap1bpp(bits, WIDTH, HEIGHT, packed);
+        sink = packed[0];
+    });
+    run("packBitmap (std::vector)", [&] {
+        sink = FutabaNAGP1250::packBitmap(bitmapVector, WIDTH, HEIGHT)[0];
+    });
+}
+
+void benchmarkDrawing() {
+    section("Draw primitives, framebuffer");
+
+    FutabaNAGP1250Framebuffer frame(WIDTH, HEIGHT);
+    FutabaNAGP1250::GraphicLine radial[36];
+    for (uint8_t i = 0; i < 36; ++i) {
+        radial[i] = {70, 16, i * 10.0f, 15};
+    }
+
+    run("setPixel (full frame)", [&] {
+        for (uint16_t y = 0; y < HEIGHT; ++y) {
+            for (uint16_t x = 0; x < WIDTH; ++x) {
+                frame.setPixel(x, y, (x ^ y) & 1);
+            }
+        }
+    });
+    run("fillRect 100x20", [&] { frame.fillRect(20, 6, 100, 20, true); });
+    run("drawGraphicLine diagonal", [&] { FutabaNAGP1250::drawGraphicLine(frame, 0, 0, 139, 31); });
+    run("drawGraphicLine horizontal", [&] { FutabaNAGP1250::drawGraphicLine(frame, 0, 13, 139, 13); });
+    run("drawGraphicLine vertical", [&] { FutabaNAGP1250::drawGraphicLine(frame, 70, 0, 70, 31); });
+    run("drawGraphicLines 36 radial", [&] { FutabaNAGP1250::drawGraphicLines(frame, radial, 36); });
+    run("drawGraphicCircle r15", [&] { FutabaNAGP1250::drawGraphicCircle(frame, 70, 16, 15); });
+    run("drawGraphicCircleFilled r15", [&] { FutabaNAGP1250::drawGraphicCircleFilled(frame, 70, 16, 15); });
+    run("drawGraphicBox 100x24", [&] { FutabaNAGP1250::drawGraphicBox(frame, 20, 4, 100, 24); });
+    run("drawGraphicBox 100x24 r6", [&] { FutabaNAGP1250::drawGraphicBox(frame, 20, 4, 100, 24, 6); });
+    run("drawGraphicBox 100x24 filled", [&] { FutabaNAGP1250::drawGraphicBox(frame, 20, 4, 100, 24, 0, true); });
+    run("drawGraphicBox 100x24 r6 filled", [&] { FutabaNAGP1250::drawGraphicBox(frame, 20, 4, 100, 24, 6, true); });
+    uint8_t sprite[16 * 2];
+    for (uint8_t i = 0; i < sizeof(sprite); ++i) {
+        sprite[i] = static_cast<uint8_t>(i * 37 + 11);
+    }
+    run("drawSprite 16x16, byte row aligned", [&] { FutabaNAGP1250::drawSprite(frame, sprite, 16, 16, 60, 8); });
+    run("drawSprite 16x16 XOR, y offset 3", [&] {
+        FutabaNAGP1250::drawSprite(frame, sprite, 16, 16, 60, 3, FutabaNAGP1250::WRITE_MODE_XOR);
+    });
+    run("drawSprite 16x16 OR mirrored, clipped", [&] {
+        FutabaNAGP1250::drawSprite(frame, sprite, 16, 16, 130, -5, FutabaNAGP1250::WRITE_MODE_OR, true);
+    });
+    FutabaNAGP1250TextRenderer text;
+    run("drawText 20 chars, byte row aligned", [&] { text.drawText(frame, 10, 8, "Benchmark 1234567890"); });
+    run("drawText 20 chars, y offset 3", [&] { text.drawText(frame, 10, 3, "Benchmark 1234567890"); });
+    run("drawText 20 chars, y offset 3, cold cache", [&] {
+        text.clearCache();
+        text.drawText(frame, 10, 3, "Benchmark 1234567890");
+    });
+    run("clear", [&] { frame.clear(); });
+
+    section("Draw primitives, std::vector bitmap");
+
+    std::vector<uint8_t> bitmap(WIDTH * HEIGHT);
+    std::vector<FutabaNAGP1250::GraphicLine> radialVector(radial, radial + 36);
+    run("vector drawGraphicLine diagonal", [&] {
+        FutabaNAGP1250::drawGraphicLine(bitmap, 0, 0, 139, 31, WIDTH, HEIGHT);
+    });
+    run("vector drawGraphicLines 36 radial", [&] {
+        FutabaNAGP1250::drawGraphicLines(bitmap, WIDTH, HEIGHT, radialVector);
+    });
+    run("vector drawGraphicCircle r15", [&] {
+        FutabaNAGP1250::drawGraphicCircle(bitmap, 70, 16, 15, WIDTH, HEIGHT);
+    });
+    run("vector drawGraphicCircleFilled r15", [&] {
+        FutabaNAGP1250::drawGraphicCircleFilled(bitmap, 70, 16, 15, WIDTH, HEIGHT);
+    });
+    run("vector drawGraphicBox 100x24 r6 filled", [&] {
+        FutabaNAGP1250::drawGraphicBox(bitmap, 20, 4, 100, 24, WIDTH, HEIGHT, 6, true);
+    });
+}
+
+void benchmarkEncoding() {
+    section("Command encoding (null transport)");
+
+    NullTransport transport;
+    FutabaNAGP1250 vfd(transport);
+    vfd.begin();
+
+    auto overlay = [&] {
+        vfd.setWriteLogic(FutabaNAGP1250::WRITE_MODE_XOR);
+        vfd.setCursorPosition(75, 1);
+        vfd.writeText("XOR");
+        vfd.setWriteLogic(FutabaNAGP1250::WRITE_MODE_NORMAL);
+    };
+    runWithoutAllocations("setCursorPosition", [&] { vfd.setCursorPosition(75, 1); });
+    runWithoutAllocations("writeText 20 chars", [&] { vfd.writeText("Benchmark 1234567890"); });
+    runWithoutAllocations("overlay update, separate", overlay);
+    runWithoutAllocations("overlay update, batched", [&] {
+        FutabaNAGP1250::Batch batch(vfd);
+        overlay();
+    });
+
+    FutabaNAGP1250Framebuffer frame(WIDTH, HEIGHT);
+    FutabaNAGP1250::drawGraphicCircleFilled(frame, 70, 16, 12);
+    // The same overlay drawn into the framebuffer: inverted text over the filled circle, sent
+    // as one dirty region. Alternates between two labels so every flush has something to send.
+    FutabaNAGP1250TextRenderer text;
+    text.setOpaque(true);
+    bool toggle = false;
+    runWithoutAllocations("overlay update, framebuffer text + flush", [&] {
+        toggle = !toggle;
+        text.drawText(frame, 62, 8, toggle ? "XOR" : "OR ", false);
+        vfd.flush(frame);
+    });
+    runWithoutAllocations("displayGraphicImage (encode only)", [&] { vfd.displayGraphicImage(frame); });
+
+    // A 5x7 icon drawn at a fixed spot, as a bit image and as a cached download character.
+    static const uint8_t icon[FutabaNAGP1250CharacterCache::GLYPH_WIDTH] = {0x38, 0x7C, 0x7C, 0x7C, 0x38};
+    FutabaNAGP1250Framebuffer iconFrame(6, 8);
+    memcpy(iconFrame.data(), icon, sizeof(icon));
+    FutabaNAGP1250CharacterCache icons(vfd);
+    auto iconImage = [&] {
+        vfd.setCursorPosition(130, 0);
+        vfd.displayGraphicImage(iconFrame);
+    };
+    auto iconCharacter = [&] {
+        vfd.setCursorPosition(130, 0);
+        icons.write(icon);
+    };
+    iconCharacter(); // the download itself is not part of the steady state
+    char note[48];
+    snprintf(note, sizeof(note), "%llu bytes on the wire", static_cast<unsigned long long>(wireBytes(transport, iconImage)));
+    runWithoutAllocations("icon, bit image", iconImage, note);
+    snprintf(note, sizeof(note), "%llu bytes on the wire", static_cast<unsigned long long>(wireBytes(transport, iconCharacter)));
+    runWithoutAllocations("icon, cached download character", iconCharacter, note);
+
+    // UI code that restates its settings every frame; the shadow state drops what is unchanged.
+    auto settings = [&] {
+        vfd.setWriteLogic(FutabaNAGP1250::WRITE_MODE_NORMAL);
+        vfd.setLuminance(4);
+        vfd.setFont(FutabaNAGP1250::FONT_AMERICA);
+        vfd.setCharacterCode(FutabaNAGP1250::CHAR_CODE_PC437);
+        vfd.selectWindow(0);
+        vfd.setFontMagnification(1, 1);
+    };
+    settings();
+    snprintf(note, sizeof(note), "%llu bytes on the wire", static_cast<unsigned long long>(wireBytes(transport, settings)));
+    runWithoutAllocations("restated settings, shadowed", settings, note);
+    vfd.setStateShadowing(false);
+    snprintf(note, sizeof(note), "%llu bytes on the wire", static_cast<unsigned long long>(wireBytes(transport, settings)));
+    runWithoutAllocations("restated settings, not shadowed", settings, note);
+    vfd.setStateShadowing(true);
+    runWithoutAllocations("flush 8x8 dirty region", [&] {
+        frame.fillRect(60, 8, 8, 8, frame.getPixel(60, 8) == 0);
+        vfd.flush(frame);
+    });
+
+    // A trend graph on a virtual canvas: each step renders and sends only the
+    // exposed columns, then lets the hardware scroll them into view.
+    FutabaNAGP1250ScrollCanvas canvas(vfd, [](FutabaNAGP1250Framebuffer& strip, uint32_t x, void*) {
+        for (uint16_t i = 0; i < strip.width(); ++i) {
+            strip.setPixel(i, 24 + static_cast<int16_t>((x + i) * 7 % 8));
+        }
+    });
+    canvas.begin();
+    auto scrollOne = [&] { canvas.scroll(1); };
+    auto scrollEight = [&] { canvas.scroll(8); };
+    snprintf(note, sizeof(note), "%llu bytes on the wire", static_cast<unsigned long long>(wireBytes(transport, scrollOne)));
+    runWithoutAllocations("scroll canvas, 1 column", scrollOne, note);
+    snprintf(note, sizeof(note), "%llu bytes on the wire", static_cast<unsigned long long>(wireBytes(transport, scrollEight)));
+    runWithoutAllocations("scroll canvas, 8 columns", scrollEight, note);
+
+    // The same scene rendered into a full framebuffer and through 16-column strips.
+    auto scene = [](FutabaNAGP1250Framebuffer& f, void*) {
+        FutabaNAGP1250::drawGraphicCircle(f, 70, 16, 15);
+        FutabaNAGP1250::drawGraphicLines(f, {{70, 16, 30, 15}, {70, 16, 150, 15}, {70, 16, 270, 15}});
+        FutabaNAGP1250::drawGraphicBox(f, 0, 0, 44, 32, 4);
+        FutabaNAGP1250::drawGraphicBox(f, 96, 0, 44, 32, 4, true);
+    };
+    FutabaNAGP1250Framebuffer sceneFrame(WIDTH, HEIGHT);
+    auto fullFrame = [&] {
+        sceneFrame.clear();
+        scene(sceneFrame, nullptr);
+        vfd.setCursorPosition(0, 0);
+        vfd.displayGraphicImage(sceneFrame);
+    };
+    FutabaNAGP1250StripRenderer strips(vfd, scene, nullptr, 16);
+    auto stripFrame = [&] { strips.draw(); };
+    snprintf(note, sizeof(note), "%llu bytes on the wire, 560 bytes RAM",
+             static_cast<unsigned long long>(wireBytes(transport, fullFrame)));
+    runWithoutAllocations("scene, framebuffer + upload", fullFrame, note);
+    snprintf(note, sizeof(note), "%llu bytes on the wire, 64 bytes RAM",
+             static_cast<unsigned long long>(wireBytes(transport, stripFrame)));
+    runWithoutAllocations("scene, 16-column strips", stripFrame, note);
+}
+
+void benchmarkFrames() {
+    section("Full-frame upload, modelled link");
+
+    char note[96];
+    FutabaNAGP1250Framebuffer frame(WIDTH, HEIGHT);
+    FutabaNAGP1250::drawGraphicCircleFilled(frame, 70, 16, 12);
+    const uint32_t frameBytes = frame.size() + 9; // bit image header + payload
+
+    // SBUSY wired: the emulator's per-byte processing cost paces the link on a virtual clock.
+    FutabaNAGP1250Emulator emulator;
+    FutabaNAGP1250EmulatorTransport emulated(emulator, SPI_FREQUENCY);
+    FutabaNAGP1250 vfd(emulated);
+    vfd.begin();
+    auto upload = [&] {
+        vfd.setCursorPosition(0, 0);
+        vfd.displayGraphicImage(frame);
+    };
+    constexpr uint16_t MODEL_FRAMES = 100;
+    const uint32_t startUs = emulated.nowUs();
+    for (uint16_t i = 0; i < MODEL_FRAMES; ++i) {
+        upload();
+    }
+    const double frameUs = static_cast<double>(emulated.nowUs() - startUs) / MODEL_FRAMES;
+    snprintf(note, sizeof(note), "modelled %.1f FPS, %.0f bytes/s, %u overruns",
+             1e6 / frameUs, frameBytes * 1e6 / frameUs, static_cast<unsigned>(emulator.overruns()));
+    run("displayGraphicImage, SBUSY (emulated)", upload, note);
+
+    // No SBUSY: the fixed byte spacing dominates; the stub delay returns at once, so the
+    // measured time is the CPU cost and the modelled rate follows from the spacing.
+    FutabaNAGP1250 timed(SPI, -1, -1, SPI_FREQUENCY);
+    timed.begin();
+    const double timedFrameUs = frameBytes * (NO_SBUSY_BYTE_DELAY_US + 8e6 / SPI_FREQUENCY);
+    snprintf(note, sizeof(note), "modelled %.2f FPS, %.0f bytes/s",
+             1e6 / timedFrameUs, frameBytes * 1e6 / timedFrameUs);
+    run("displayGraphicImage, fixed delay", [&] { timed.displayGraphicImage(frame); }, note);
+}
+
+// Several producer threads updating one display: through the lock-free display service (one
+// consumer thread owns the driver) versus the baseline of sharing the driver under a mutex.
+// Reports the time per message overall and the producers' post latency percentiles.
+constexpr uint8_t PRODUCERS = 4;
+constexpr uint32_t MESSAGES_PER_PRODUCER = 5000;
+constexpr uint32_t WIRE_NS_PER_BYTE = 1000;
+
+// Occupies the calling thread for the modelled wire time of every byte, like a blocking SPI
+// transfer would.
+class WireTimeTransport : public NullTransport {
+public:
+    using FutabaNAGP1250Transport::write;
+    void write(const uint8_t* data, size_t blocks, size_t blockLength, size_t stride) override {
+        NullTransport::write(data, blocks, blockLength, stride);
+        occupy(blocks * blockLength);
+    }
+
+private:
+    static void occupy(size_t bytes) {
+        using Clock = std::chrono::steady_clock;
+        const Clock::time_point until = Clock::now() + std::chrono::nanoseconds(bytes * WIRE_NS_PER_BYTE);
+        while (Clock::now() < until) {}
+    }
+};
+
+void encodeMessage(FutabaNAGP1250& display, uint8_t producer, uint32_t index) {
+    char text[16];
+    snprintf(text, sizeof(text), "%u:%05lu", producer, static_cast<unsigned long>(index % 100000));
+    display.setCursorPosition(producer * 35, 1);
+    display.writeText(text);
+}
+
+void printContention(const char* name, double seconds, std::vector<uint32_t>& latencies) {
+    const uint32_t messages = PRODUCERS * MESSAGES_PER_PRODUCER;
+    std::sort(latencies.begin(), latencies.end());
+    char note[96];
+    snprintf(note, sizeof(note), "post latency p50 %u ns, p99 %u ns, max %u ns",
+             latencies[latencies.size() / 2], latencies[latencies.size() * 99 / 100], latencies.back());
+    printf("%-40s %12.1f ns/op %8s            %s\n", name, seconds * 1e9 / messages, "", note);
+}
+
+template <typename Post>
+double runProducers(std::vector<uint32_t>& latencies, Post post) {
+    using Clock = std::chrono::steady_clock;
+    latencies.assign(PRODUCERS * MESSAGES_PER_PRODUCER, 0);
+    std::vector<std::thread> threads;
+    const Clock::time_point start = Clock::now();
+    for (uint8_t producer = 0; producer < PRODUCERS; ++producer) {
+        threads.emplace_back([&, producer] {
+            uint32_t* samples = latencies.data() + producer * MESSAGES_PER_PRODUCER;
+            for (uint32_t i = 0; i < MESSAGES_PER_PRODUCER; ++i) {
+                const Clock::time_point begin = Clock::now();
+                post(producer, i);
+                samples[i] = static_cast<uint32_t>(std::chrono::nanoseconds(Clock::now() - begin).count());
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+void benchmarkContention() {
+    if (filter && !strstr("contention", filter)) {
+        return;
+    }
+    section("Multi-producer contention");
+    printf("%u producers x %lu messages, %lu ns wire time per byte, %u hardware threads\n", PRODUCERS,
+           static_cast<unsigned long>(MESSAGES_PER_PRODUCER), static_cast<unsigned long>(WIRE_NS_PER_BYTE),
+           std::thread::hardware_concurrency());
+
+    std::vector<uint32_t> latencies;
+    {
+        WireTimeTransport transport;
+        FutabaNAGP1250 vfd(transport);
+        std::mutex lock;
+        const double seconds = runProducers(latencies, [&](uint8_t producer, uint32_t index) {
+            std::lock_guard<std::mutex> guard(lock);
+            encodeMessage(vfd, producer, index);
+        });
+        printContention("contention: mutex-wrapped driver", seconds, latencies);
+    }
+    {
+        WireTimeTransport transport;
+        FutabaNAGP1250 vfd(transport);
+        FutabaNAGP1250DisplayService service(vfd, 64);
+        std::atomic<bool> done(false);
+        std::thread consumer([&] {
+            while (!done.load()) {
+                if (!service.process()) {
+                    yield();
+                }
+            }
+            service.process();
+        });
+        std::vector<std::unique_ptr<FutabaNAGP1250DisplayService::Producer>> producers;
+        for (uint8_t producer = 0; producer < PRODUCERS; ++producer) {
+            producers.emplace_back(new FutabaNAGP1250DisplayService::Producer(service));
+        }
+        const double seconds = runProducers(latencies, [&](uint8_t producer, uint32_t index) {
+            FutabaNAGP1250DisplayService::Producer& encoder = *producers[producer];
+            encodeMessage(encoder.display(), producer, index);
+            encoder.post();
+        });
+        done.store(true);
+        consumer.join();
+        printContention("contention: lock-free display service", seconds, latencies);
+    }
+}
+
+} // namespace
+
+void* operator new(size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+int main(int argc, char** argv) {
+    if (argc > 1) {
+        filter = argv[1];
+    }
+    benchmarkPacking();
+    benchmarkDrawing();
+    benchmarkEncoding();
+    benchmarkFrames();
+    benchmarkContention();
+    return failures ? 1 : 0;
+}
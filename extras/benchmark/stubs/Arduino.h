@@ -0,0 +1,96 @@
+#pragma once
+
+// Minimal host stand-in for the Arduino core, just enough to build the library on Linux for
+// the benchmark. Time is real (steady_clock); delays return immediately, so transport waits
+// cost nothing and only CPU work is measured.
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define CHANGE 1
+#define FALLING 2
+#define RISING 3
+#define LSBFIRST 0
+#define MSBFIRST 1
+
+#ifndef PI
+#define PI 3.1415926535897932384626433832795
+#endif
+#define DEG_TO_RAD 0.017453292519943295769236907684886
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+template <class A, class B>
+auto min(A a, B b) -> typename std::common_type<A, B>::type { return a < b ? a : b; }
+template <class A, class B>
+auto max(A a, B b) -> typename std::common_type<A, B>::type { return a > b ? a : b; }
+
+#define PROGMEM
+#define pgm_read_byte(p) (*(const uint8_t*)(p))
+#define pgm_read_word(p) (*(const uint16_t*)(p))
+#define pgm_read_dword(p) (*(const uint32_t*)(p))
+
+class __FlashStringHelper;
+#define F(s) reinterpret_cast<const __FlashStringHelper*>(s)
+
+inline int hostPins[64];
+inline void pinMode(int, int) {}
+inline int digitalRead(int pin) { return hostPins[pin & 63]; }
+inline void digitalWrite(int pin, int value) { hostPins[pin & 63] = value; }
+
+inline int digitalPinToInterrupt(int pin) { return pin; }
+inline void attachInterrupt(int, void (*)(), int) {}
+inline void detachInterrupt(int) {}
+inline void noInterrupts() {}
+inline void interrupts() {}
+
+inline unsigned long micros() {
+    using namespace std::chrono;
+    static const steady_clock::time_point start = steady_clock::now();
+    return static_cast<unsigned long>(duration_cast<microseconds>(steady_clock::now() - start).count());
+}
+inline unsigned long millis() { return micros() / 1000; }
+inline void delay(unsigned long) {}
+inline void delayMicroseconds(unsigned int) {}
+inline void yield() { std::this_thread::yield(); }
+
+class String : public std::string {
+public:
+    using std::string::string;
+    String(const std::string& s) : std::string(s) {}
+};
+
+// Serial output goes to stdout.
+struct HostSerial {
+    void begin(long) {}
+    explicit operator bool() const { return true; }
+    void print(const char* s) { fputs(s, stdout); }
+    void print(const __FlashStringHelper* s) { fputs(reinterpret_cast<const char*>(s), stdout); }
+    void print(char c) { fputc(c, stdout); }
+    void print(long v) { printf("%ld", v); }
+    void print(unsigned long v) { printf("%lu", v); }
+    void print(int v) { printf("%d", v); }
+    void print(unsigned int v) { printf("%u", v); }
+    void print(double v, int digits = 2) { printf("%.*f", digits, v); }
+    template <class T>
+    void println(T v) { print(v); println(); }
+    void println(double v, int digits) { print(v, digits); println(); }
+    void println() { fputc('\n', stdout); }
+};
+inline HostSerial Serial;
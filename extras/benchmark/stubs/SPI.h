@@ -0,0 +1,32 @@
+#pragma once
+
+// Host SPI stand-in: transfers only count the bytes that would have gone on the wire.
+
+#include "Arduino.h"
+
+#define SPI_MODE0 0
+
+struct SPISettings {
+    SPISettings() {}
+    SPISettings(uint32_t, uint8_t, uint8_t) {}
+};
+
+class SPIClass {
+public:
+    void begin() {}
+    void end() {}
+    void beginTransaction(SPISettings) {}
+    void endTransaction() {}
+    uint8_t transfer(uint8_t value) {
+        ++bytes_;
+        return value;
+    }
+    void transfer(void*, size_t length) { bytes_ += length; }
+
+    uint64_t bytes() const { return bytes_; }
+
+private:
+    uint64_t bytes_ = 0;
+};
+
+inline SPIClass SPI;
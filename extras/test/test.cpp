@@ -0,0 +1,827 @@
+// Host tests for the FutabaNAGP1250 library.
+//
+// Builds on Linux against the benchmark's stubs (see the Makefile). Each test prints one line,
+// failed checks print their location, and the program exits with status 1 if any check failed.
+// The concurrency tests are meant to be run under ThreadSanitizer as well (`make tsan`).
+//
+// An optional argument only runs the tests whose name contains it, e.g. `./test service`.
+
+#include <FutabaNAGP1250.h>
+#include <FutabaNAGP1250DisplayService.h>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// ---------------------------------------------------------------------------------------
+// Harness
+// ---------------------------------------------------------------------------------------
+
+const char* filter = nullptr;
+int failedChecks = 0;
+int failedTests = 0;
+
+#define CHECK(condition)                                                          \
+    do {                                                                          \
+        if (!(condition)) {                                                       \
+            printf("  %s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+            ++failedChecks;                                                       \
+        }                                                                         \
+    } while (0)
+
+void test(const char* name, void (*fn)()) {
+    if (filter && !strstr(name, filter)) {
+        return;
+    }
+    const int before = failedChecks;
+    fn();
+    const bool passed = failedChecks == before;
+    printf("%-60s %s\n", name, passed ? "ok" : "FAILED");
+    failedTests += !passed;
+}
+
+// Small deterministic generator, so a failure reproduces on every run.
+class Random {
+public:
+    explicit Random(uint32_t seed) : state_(seed ? seed : 1) {}
+    uint32_t next() {
+        state_ ^= state_ << 13;
+        state_ ^= state_ >> 17;
+        state_ ^= state_ << 5;
+        return state_;
+    }
+    // 0 .. bound - 1
+    uint32_t below(uint32_t bound) { return next() % bound; }
+
+private:
+    uint32_t state_;
+};
+
+// Records every byte the driver sends.
+class RecordingTransport : public FutabaNAGP1250Transport {
+public:
+    using FutabaNAGP1250Transport::write;
+    void write(const uint8_t* data, size_t blocks, size_t blockLength, size_t stride) override {
+        for (size_t block = 0; block < blocks; ++block) {
+            bytes.insert(bytes.end(), data + block * stride, data + block * stride + blockLength);
+        }
+    }
+    size_t writeAvailable(const uint8_t* data, size_t length) override {
+        bytes.insert(bytes.end(), data, data + length);
+        return length;
+    }
+    bool busy() override { return false; }
+    bool waitIdle(uint32_t) override { return true; }
+
+    std::vector<uint8_t> bytes;
+};
+
+// ---------------------------------------------------------------------------------------
+// Display service
+// ---------------------------------------------------------------------------------------
+
+constexpr uint8_t PRODUCERS = 4;
+constexpr uint32_t MESSAGES_PER_PRODUCER = 20000;
+
+// A message identifies its producer and sequence number; its length varies so that messages
+// span one to three ring slots:
+//     0x80 | producer, sequence (3 bytes, LSB first), n, n payload bytes (sequence + i)
+size_t encodeMessage(uint8_t* out, uint8_t producer, uint32_t sequence) {
+    const uint8_t payload = static_cast<uint8_t>((sequence * 7 + producer * 13) % 90);
+    size_t length = 0;
+    out[length++] = 0x80 | producer;
+    out[length++] = static_cast<uint8_t>(sequence);
+    out[length++] = static_cast<uint8_t>(sequence >> 8);
+    out[length++] = static_cast<uint8_t>(sequence >> 16);
+    out[length++] = payload;
+    for (uint8_t i = 0; i < payload; ++i) {
+        out[length++] = static_cast<uint8_t>(sequence + i);
+    }
+    return length;
+}
+
+// Many producers against one consumer: every message reaches the wire exactly once, whole and
+// uninterleaved, and each producer's messages arrive in the order they were posted.
+void testServiceDeliversEveryMessageOnceInOrder() {
+    RecordingTransport transport;
+    FutabaNAGP1250 vfd(transport);
+    // Small enough that producers regularly find it full and have to wait.
+    FutabaNAGP1250DisplayService service(vfd, 16);
+
+    std::atomic<bool> done(false);
+    std::thread consumer([&] {
+        while (!done.load()) {
+            if (!service.process()) {
+                yield();
+            }
+        }
+        while (service.process()) {}
+    });
+    std::vector<std::thread> producers;
+    std::atomic<uint32_t> failedPosts(0);
+    for (uint8_t producer = 0; producer < PRODUCERS; ++producer) {
+        producers.emplace_back([&, producer] {
+            uint8_t message[128];
+            for (uint32_t i = 0; i < MESSAGES_PER_PRODUCER; ++i) {
+                if (!service.post(message, encodeMessage(message, producer, i))) {
+                    failedPosts.fetch_add(1);
+                }
+            }
+        });
+    }
+    for (std::thread& producer : producers) {
+        producer.join();
+    }
+    done.store(true);
+    consumer.join();
+    CHECK(failedPosts.load() == 0);
+    CHECK(service.pending() == 0);
+
+    const std::vector<uint8_t>& wire = transport.bytes;
+    uint32_t next[PRODUCERS] = {};
+    size_t position = 0;
+    bool intact = true;
+    while (intact && position + 5 <= wire.size()) {
+        const uint8_t producer = wire[position] & 0x7F;
+        const uint32_t sequence = wire[position + 1] | wire[position + 2] << 8 | wire[position + 3] << 16;
+        const uint8_t payload = wire[position + 4];
+        intact = (wire[position] & 0x80) && producer < PRODUCERS && position + 5 + payload <= wire.size();
+        if (!intact) {
+            break;
+        }
+        CHECK(sequence == next[producer]);
+        for (uint8_t i = 0; i < payload; ++i) {
+            intact &= wire[position + 5 + i] == static_cast<uint8_t>(sequence + i);
+        }
+        next[producer] = sequence + 1;
+        position += 5 + payload;
+    }
+    CHECK(intact);
+    CHECK(position == wire.size());
+    for (uint8_t producer = 0; producer < PRODUCERS; ++producer) {
+        CHECK(next[producer] == MESSAGES_PER_PRODUCER);
+    }
+}
+
+// A full ring refuses messages instead of overwriting queued ones, and takes them again once
+// the consumer has made room.
+void testServiceBackpressure() {
+    RecordingTransport transport;
+    FutabaNAGP1250 vfd(transport);
+    FutabaNAGP1250DisplayService service(vfd, 4);
+    CHECK(service.capacity() == 4);
+
+    uint8_t message[FutabaNAGP1250DisplayService::SLOT_BYTES * 5];
+    for (size_t i = 0; i < sizeof(message); ++i) {
+        message[i] = static_cast<uint8_t>(i);
+    }
+    const size_t oneSlot = FutabaNAGP1250DisplayService::SLOT_BYTES;
+    for (uint8_t i = 0; i < 4; ++i) {
+        CHECK(service.tryPost(message, oneSlot));
+    }
+    CHECK(service.pending() == 4);
+    CHECK(!service.tryPost(message, 1));
+    CHECK(!service.post(message, 1, 1000));
+    CHECK(service.rejected() == 2);
+
+    CHECK(service.process() == 4);
+    CHECK(transport.bytes.size() == 4 * oneSlot);
+    // Never fits, even into an empty ring.
+    CHECK(!service.post(message, sizeof(message), 1000));
+    CHECK(service.rejected() == 3);
+    // Two slots left after this one; a three-slot message has to wait for the consumer.
+    CHECK(service.tryPost(message, 2 * oneSlot));
+    CHECK(!service.tryPost(message, 3 * oneSlot));
+    CHECK(service.process() == 1);
+    CHECK(service.tryPost(message, 3 * oneSlot));
+    CHECK(service.process() == 1);
+    CHECK(transport.bytes.size() == 9 * oneSlot);
+    CHECK(service.rejected() == 4);
+}
+
+// A producer spinning on tryPost() against a busy consumer gets every message through once the
+// consumer catches up; the refusals are counted, nothing is lost or duplicated.
+void testServiceTryPostUnderContention() {
+    RecordingTransport transport;
+    FutabaNAGP1250 vfd(transport);
+    FutabaNAGP1250DisplayService service(vfd, 8);
+
+    std::atomic<bool> done(false);
+    std::thread consumer([&] {
+        while (!done.load()) {
+            if (!service.process(1)) {
+                yield();
+            }
+        }
+        while (service.process()) {}
+    });
+    uint32_t refused = 0;
+    uint8_t message[128];
+    for (uint32_t i = 0; i < MESSAGES_PER_PRODUCER; ++i) {
+        const size_t length = encodeMessage(message, 0, i);
+        while (!service.tryPost(message, length)) {
+            ++refused;
+            yield();
+        }
+    }
+    done.store(true);
+    consumer.join();
+    CHECK(service.rejected() == refused);
+
+    size_t position = 0;
+    uint32_t expected = 0;
+    uint8_t reference[128];
+    while (position < transport.bytes.size()) {
+        const size_t length = encodeMessage(reference, 0, expected);
+        if (position + length > transport.bytes.size() ||
+            memcmp(transport.bytes.data() + position, reference, length) != 0) {
+            break;
+        }
+        position += length;
+        ++expected;
+    }
+    CHECK(expected == MESSAGES_PER_PRODUCER);
+    CHECK(position == transport.bytes.size());
+}
+
+// ---------------------------------------------------------------------------------------
+// Frame codec
+// ---------------------------------------------------------------------------------------
+
+// Changes `frame` the way the different sources of a stream do: a few pixels, a moving shape,
+// noise, or nothing at all.
+void mutateFrame(FutabaNAGP1250Framebuffer& frame, Random& random) {
+    switch (random.below(6)) {
+        case 0:
+            for (uint8_t i = random.below(8); i; --i) {
+                frame.setPixel(random.below(frame.width()), random.below(frame.height()), random.below(2));
+            }
+            break;
+        case 1:
+            FutabaNAGP1250::drawGraphicCircleFilled(frame, random.below(frame.width()), random.below(frame.height()),
+                                                    1 + random.below(12));
+            break;
+        case 2:
+            frame.fillRect(random.below(frame.width()), random.below(frame.height()), random.below(80),
+                           random.below(frame.height()), random.below(2));
+            break;
+        case 3:
+            for (size_t i = 0; i < frame.size(); ++i) {
+                frame.data()[i] = static_cast<uint8_t>(random.next());
+            }
+            break;
+        case 4: {
+            // A long run of one value, often longer than one repeat code covers.
+            const size_t start = random.below(frame.size());
+            const uint8_t value = static_cast<uint8_t>(random.next());
+            memset(frame.data() + start, value, min(static_cast<size_t>(random.below(400)), frame.size() - start));
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+// Feeds `data` to the decoder in chunks of random size and returns the frames completed.
+uint32_t feed(FutabaNAGP1250FrameDecoder& decoder, const uint8_t* data, size_t length, Random& random) {
+    uint32_t completed = 0;
+    while (length) {
+        const size_t chunk = min(static_cast<size_t>(1 + random.below(64)), length);
+        completed += decoder.write(data, chunk);
+        data += chunk;
+        length -= chunk;
+    }
+    return completed;
+}
+
+// Every encoded frame decodes back to exactly the frame that was encoded, key and delta frames
+// alike, whatever sizes the stream arrives in.
+void testCodecRoundTripIntoFramebuffer() {
+    const uint16_t widths[] = {140, 256, 1, 37};
+    const uint8_t heights[] = {32, 32, 8, 24};
+    for (uint8_t shape = 0; shape < 4; ++shape) {
+        Random random(shape + 1);
+        FutabaNAGP1250Framebuffer source(widths[shape], heights[shape]);
+        FutabaNAGP1250Framebuffer decoded(widths[shape], heights[shape]);
+        FutabaNAGP1250FrameEncoder encoder(source.width(), source.byteRows());
+        FutabaNAGP1250FrameDecoder decoder;
+        decoder.begin(decoded);
+        std::vector<uint8_t> encoded(FutabaNAGP1250FrameEncoder::maxEncodedSize(source.width(), source.byteRows()));
+
+        for (uint16_t i = 0; i < 500; ++i) {
+            mutateFrame(source, random);
+            const size_t length = encoder.encode(source, encoded.data(), encoded.size(), random.below(20) == 0);
+            CHECK(length >= FutabaNAGP1250FrameEncoder::HEADER_SIZE && length <= encoded.size());
+            CHECK(feed(decoder, encoded.data(), length, random) == 1);
+            CHECK(!decoder.inFrame());
+            CHECK(memcmp(decoded.data(), source.data(), source.size()) == 0);
+        }
+        CHECK(decoder.framesDecoded() == 500);
+        CHECK(decoder.framesRejected() == 0);
+    }
+}
+
+// Decoding straight to the display leaves the module showing the encoded frames, whatever it
+// showed and whichever write logic was set before.
+void testCodecRoundTripToDisplay() {
+    Random random(7);
+    FutabaNAGP1250Emulator emulator;
+    FutabaNAGP1250EmulatorTransport transport(emulator, 4000000);
+    FutabaNAGP1250 vfd(transport);
+    vfd.begin();
+    FutabaNAGP1250Framebuffer source(140, 32);
+    FutabaNAGP1250FrameEncoder encoder;
+    FutabaNAGP1250FrameDecoder decoder;
+    decoder.begin(vfd);
+    std::vector<uint8_t> encoded(FutabaNAGP1250FrameEncoder::maxEncodedSize(140, 4));
+
+    // The sketch left lit pixels and the OR write logic behind, which key frames must override.
+    FutabaNAGP1250Framebuffer lit(140, 32);
+    lit.fillRect(0, 0, 140, 32, true);
+    vfd.flush(lit);
+    uint32_t mismatches = 0;
+    for (uint16_t i = 0; i < 200; ++i) {
+        mutateFrame(source, random);
+        const bool key = random.below(8) == 0;
+        if (i == 0 || key) {
+            vfd.setWriteLogic(FutabaNAGP1250::WRITE_MODE_OR);
+        }
+        const size_t length = encoder.encode(source, encoded.data(), encoded.size(), key);
+        vfd.setCursorPosition(0, 0);
+        feed(decoder, encoded.data(), length, random);
+        for (uint16_t y = 0; y < 32; ++y) {
+            for (uint16_t x = 0; x < 140; ++x) {
+                mismatches += emulator.pixel(x, y) != source.getPixel(x, y);
+            }
+        }
+    }
+    CHECK(mismatches == 0);
+    CHECK(emulator.writeLogic() == FutabaNAGP1250::WRITE_MODE_NORMAL);
+    CHECK(emulator.overruns() == 0);
+}
+
+// Garbage and damaged streams never write outside the target, and the decoder takes a valid
+// stream again after begin().
+void testCodecFuzz() {
+    Random random(11);
+    FutabaNAGP1250Framebuffer source(140, 32);
+    FutabaNAGP1250Framebuffer decoded(140, 32);
+    FutabaNAGP1250FrameEncoder encoder;
+    FutabaNAGP1250FrameDecoder decoder;
+    std::vector<uint8_t> encoded(FutabaNAGP1250FrameEncoder::maxEncodedSize(140, 4));
+    FutabaNAGP1250Emulator emulator;
+    FutabaNAGP1250EmulatorTransport transport(emulator, 4000000);
+    FutabaNAGP1250 vfd(transport);
+    vfd.begin();
+    FutabaNAGP1250FrameDecoder displayDecoder;
+    displayDecoder.begin(vfd);
+
+    for (uint16_t round = 0; round < 2000; ++round) {
+        // Either random bytes with plausible headers mixed in, or a valid stream with damage.
+        std::vector<uint8_t> input;
+        if (random.below(2)) {
+            input.resize(1 + random.below(1200));
+            for (uint8_t& byte : input) {
+                byte = static_cast<uint8_t>(random.next());
+            }
+            if (input.size() >= 4 && random.below(2)) {
+                input[0] = random.below(2) ? FutabaNAGP1250FrameEncoder::FRAME_KEY : FutabaNAGP1250FrameEncoder::FRAME_DELTA;
+            }
+        } else {
+            mutateFrame(source, random);
+            const size_t length = encoder.encode(source, encoded.data(), encoded.size());
+            input.assign(encoded.begin(), encoded.begin() + length);
+            for (uint8_t flips = 1 + random.below(4); flips; --flips) {
+                input[random.below(input.size())] ^= static_cast<uint8_t>(1 + random.below(255));
+            }
+            input.resize(1 + random.below(input.size()));
+        }
+        decoder.begin(decoded);
+        feed(decoder, input.data(), input.size(), random);
+        displayDecoder.begin(vfd);
+        feed(displayDecoder, input.data(), input.size(), random);
+        CHECK(decoded.size() == 140 * 4);
+    }
+
+    // A clean key frame after all that still decodes exactly.
+    mutateFrame(source, random);
+    encoder.reset();
+    const size_t length = encoder.encode(source, encoded.data(), encoded.size());
+    decoder.begin(decoded);
+    const uint32_t before = decoder.framesDecoded();
+    CHECK(feed(decoder, encoded.data(), length, random) == 1);
+    CHECK(decoder.framesDecoded() == before + 1);
+    CHECK(memcmp(decoded.data(), source.data(), source.size()) == 0);
+}
+
+// Frames of another size are skipped as a whole and do not disturb the ones that follow.
+void testCodecRejectsMismatchedFrames() {
+    Random random(3);
+    FutabaNAGP1250Framebuffer source(140, 32);
+    FutabaNAGP1250Framebuffer other(100, 16);
+    FutabaNAGP1250Framebuffer decoded(140, 32);
+    FutabaNAGP1250FrameEncoder encoder;
+    FutabaNAGP1250FrameEncoder otherEncoder(100, 2);
+    FutabaNAGP1250FrameDecoder decoder;
+    decoder.begin(decoded);
+    std::vector<uint8_t> encoded(FutabaNAGP1250FrameEncoder::maxEncodedSize(140, 4));
+
+    for (uint16_t i = 0; i < 100; ++i) {
+        mutateFrame(other, random);
+        const size_t otherLength = otherEncoder.encode(other, encoded.data(), encoded.size());
+        const std::vector<uint8_t> before(decoded.data(), decoded.data() + decoded.size());
+        feed(decoder, encoded.data(), otherLength, random);
+        CHECK(memcmp(decoded.data(), before.data(), before.size()) == 0);
+
+        mutateFrame(source, random);
+        const size_t length = encoder.encode(source, encoded.data(), encoded.size());
+        feed(decoder, encoded.data(), length, random);
+        CHECK(memcmp(decoded.data(), source.data(), source.size()) == 0);
+    }
+    CHECK(decoder.framesRejected() == 100);
+    CHECK(decoder.framesDecoded() == 100);
+}
+
+// ---------------------------------------------------------------------------------------
+// Drawing
+// ---------------------------------------------------------------------------------------
+
+// Column-major packing one pixel at a time: byte `x * byteRows + row` holds pixel rows
+// row * 8 .. row * 8 + 7 of column x, the topmost in the MSB.
+template <typename Lit>
+std::vector<uint8_t> referencePack(uint16_t width, uint16_t height, Lit lit) {
+    const uint8_t byteRows = (height + 7) / 8;
+    std::vector<uint8_t> packed(static_cast<size_t>(width) * byteRows);
+    for (uint16_t x = 0; x < width; ++x) {
+        for (uint16_t y = 0; y < height; ++y) {
+            if (lit(x, y)) {
+                packed[x * byteRows + y / 8] |= 0x80 >> (y % 8);
+            }
+        }
+    }
+    return packed;
+}
+
+// The block packing kernels (8x8 transposes, and a SWAR gather for byte-per-pixel input) give
+// the same bytes as packing pixel by pixel, for sizes and row strides that are not multiples of
+// eight. Framebuffer::loadBitmap packs the same way and marks exactly the bytes that changed.
+void testPackingMatchesReference() {
+    Random random(17);
+    uint32_t mismatches = 0;
+    for (uint16_t i = 0; i < 500; ++i) {
+        const uint16_t width = 1 + random.below(i < 100 ? 24 : 300);
+        const uint16_t height = 1 + random.below(i < 100 ? 24 : 40);
+        const uint8_t byteRows = (height + 7) / 8;
+        // Any nonzero byte is a lit pixel.
+        std::vector<uint8_t> bitmap(static_cast<size_t>(width) * height);
+        for (uint8_t& pixel : bitmap) {
+            pixel = random.below(2) ? static_cast<uint8_t>(random.next()) : 0;
+        }
+        // Guard bytes after the output catch writes past its end.
+        std::vector<uint8_t> packed(static_cast<size_t>(width) * byteRows + 8, 0xA5);
+        FutabaNAGP1250::packBitmap(bitmap.data(), width, height, packed.data());
+        const std::vector<uint8_t> expected =
+            referencePack(width, height, [&](uint16_t x, uint16_t y) { return bitmap[y * width + x] != 0; });
+        mismatches += !std::equal(expected.begin(), expected.end(), packed.begin());
+        mismatches += std::count(packed.begin() + expected.size(), packed.end(), 0xA5) != 8;
+
+        // Row-major 1bpp with padding after each row; 0 selects the tight stride.
+        const size_t stride = random.below(3) ? (width + 7) / 8 + random.below(4) : 0;
+        const size_t rowBytes = stride ? stride : (width + 7) / 8;
+        std::vector<uint8_t> bits(rowBytes * height);
+        for (uint8_t& byte : bits) {
+            byte = static_cast<uint8_t>(random.next());
+        }
+        std::fill(packed.begin(), packed.end(), 0xA5);
+        FutabaNAGP1250::packBitmap1bpp(bits.data(), width, height, packed.data(), stride);
+        const std::vector<uint8_t> expected1bpp = referencePack(width, height, [&](uint16_t x, uint16_t y) {
+            return (bits[y * rowBytes + x / 8] >> (7 - x % 8)) & 1;
+        });
+        mismatches += !std::equal(expected1bpp.begin(), expected1bpp.end(), packed.begin());
+        mismatches += std::count(packed.begin() + expected1bpp.size(), packed.end(), 0xA5) != 8;
+
+        // A framebuffer of the same size, holding the 1bpp image before the bitmap is loaded.
+        if (width > FutabaNAGP1250Framebuffer::MAX_WIDTH || height < 8 || height > FutabaNAGP1250Framebuffer::MAX_HEIGHT) {
+            continue;
+        }
+        FutabaNAGP1250Framebuffer frame(width, height);
+        std::copy(expected1bpp.begin(), expected1bpp.end(), frame.data());
+        frame.clearDirty();
+        CHECK(frame.loadBitmap(bitmap));
+        mismatches += !std::equal(expected.begin(), expected.end(), frame.data());
+        for (uint8_t row = 0; row < byteRows; ++row) {
+            uint16_t first = UINT16_MAX;
+            uint16_t last = 0;
+            for (uint16_t x = 0; x < width; ++x) {
+                if (expected[x * byteRows + row] != expected1bpp[x * byteRows + row]) {
+                    first = min(first, x);
+                    last = x;
+                }
+            }
+            uint16_t x0, x1;
+            const bool dirty = frame.dirtySpan(row, x0, x1);
+            mismatches += dirty != (first != UINT16_MAX) || (dirty && (x0 != first || x1 != last));
+        }
+    }
+    CHECK(mismatches == 0);
+}
+
+// Bresenham over every pixel of the segment in 32-bit arithmetic, keeping those on the bitmap.
+void referenceLine(std::vector<uint8_t>& bitmap, int16_t width, int16_t height,
+                   int32_t x0, int32_t y0, int32_t x1, int32_t y1) {
+    const int32_t dx = abs(x1 - x0);
+    const int32_t dy = -abs(y1 - y0);
+    const int32_t sx = x0 < x1 ? 1 : -1;
+    const int32_t sy = y0 < y1 ? 1 : -1;
+    int32_t error = dx + dy;
+    while (true) {
+        if (x0 >= 0 && x0 < width && y0 >= 0 && y0 < height) {
+            bitmap[y0 * width + x0] = 1;
+        }
+        if (x0 == x1 && y0 == y1) break;
+        const int32_t doubled = 2 * error;
+        if (doubled >= dy) { error += dy; x0 += sx; }
+        if (doubled <= dx) { error += dx; y0 += sy; }
+    }
+}
+
+// Pixels where the bitmap and the framebuffer, which covers the screen columns from its origin
+// on, disagree.
+uint32_t bitmapMismatches(const std::vector<uint8_t>& bitmap, uint16_t width,
+                          const FutabaNAGP1250Framebuffer& frame) {
+    uint32_t mismatches = 0;
+    for (uint16_t y = 0; y < frame.height(); ++y) {
+        for (uint16_t x = 0; x < width; ++x) {
+            const bool inside = x >= frame.originX() && x < frame.originX() + frame.width();
+            mismatches += inside && frame.getPixel(x, y) != (bitmap[y * width + x] != 0);
+        }
+    }
+    return mismatches;
+}
+
+// Segments that are thousands of pixels long or start and end far off the screen are clipped
+// to it, and the pixels that remain are exactly those of the full walk.
+void testLinesClipLongSegments() {
+    Random random(11);
+    constexpr int16_t WIDTH = 140;
+    constexpr int16_t HEIGHT = 32;
+    std::vector<uint8_t> bitmap(WIDTH * HEIGHT);
+    std::vector<uint8_t> expected(WIDTH * HEIGHT);
+    FutabaNAGP1250Framebuffer strip(40, HEIGHT);
+    strip.setOrigin(50);
+
+    // The ones that used to hang.
+    FutabaNAGP1250::drawGraphicLines(bitmap, WIDTH, HEIGHT, {{70, 16, 10, 17000}});
+    CHECK(bitmap[16 * WIDTH + 70] && bitmap[4 * WIDTH + 139]);
+    FutabaNAGP1250Framebuffer frame(WIDTH, HEIGHT);
+    FutabaNAGP1250::drawGraphicLine(frame, 0, 0, 20000, 1);
+    FutabaNAGP1250::drawGraphicLine(frame, -20000, 5, 20000, 6);
+    referenceLine(expected, WIDTH, HEIGHT, 0, 0, 20000, 1);
+    referenceLine(expected, WIDTH, HEIGHT, -20000, 5, 20000, 6);
+    uint32_t mismatches = bitmapMismatches(expected, WIDTH, frame);
+
+    for (uint16_t i = 0; i < 2000; ++i) {
+        // Each end is on the screen, near it, or anywhere in the coordinate range.
+        int16_t ends[4];
+        for (uint8_t n = 0; n < 4; ++n) {
+            const int16_t extent = n % 2 ? HEIGHT : WIDTH;
+            switch (random.below(3)) {
+                case 0:  ends[n] = static_cast<int16_t>(random.below(extent)); break;
+                case 1:  ends[n] = static_cast<int16_t>(random.below(3 * extent)) - extent; break;
+                default: ends[n] = static_cast<int16_t>(random.next()); break;
+            }
+        }
+        std::fill(bitmap.begin(), bitmap.end(), 0);
+        std::fill(expected.begin(), expected.end(), 0);
+        referenceLine(expected, WIDTH, HEIGHT, ends[0], ends[1], ends[2], ends[3]);
+        FutabaNAGP1250::drawGraphicLine(bitmap, ends[0], ends[1], ends[2], ends[3], WIDTH, HEIGHT);
+        mismatches += bitmap != expected;
+
+        frame.clear();
+        FutabaNAGP1250::drawGraphicLine(frame, ends[0], ends[1], ends[2], ends[3]);
+        mismatches += bitmapMismatches(expected, WIDTH, frame);
+        strip.clear();
+        FutabaNAGP1250::drawGraphicLine(strip, ends[0], ends[1], ends[2], ends[3]);
+        mismatches += bitmapMismatches(expected, WIDTH, strip);
+    }
+    CHECK(mismatches == 0);
+}
+
+// The angle/length form ends on the pixel the original floating-point code computed,
+//     roundf(x + cosf(angle) * (length - 1)), roundf(y - sinf(angle) * (length - 1)),
+// unless that lands within 1/64 pixel of a rounding tie, where the sine table may round the
+// other way.
+void testLinesAngleEndpoints() {
+    constexpr int16_t SIZE = 2 * 256 + 3;
+    constexpr int16_t CENTER = SIZE / 2;
+    static const uint16_t lengths[] = {1, 2, 3, 7, 16, 31, 64, 124, 140, 208, 256};
+    std::vector<uint8_t> bitmap(SIZE * SIZE);
+    uint32_t cases = 0;
+    uint32_t moved = 0;
+    uint32_t wrong = 0;
+    for (int32_t tenth = -3600; tenth < 3600; tenth += 3) {
+        // Tenths of a degree, some nudged off the decimal grid.
+        const float angle = tenth / 10.0f + (tenth % 7) * 0.013f;
+        const float radians = angle * (M_PI / 180);
+        for (uint16_t length : lengths) {
+            const int16_t x1 = static_cast<int16_t>(roundf(CENTER + cosf(radians) * (length - 1)));
+            const int16_t y1 = static_cast<int16_t>(roundf(CENTER - sinf(radians) * (length - 1)));
+            FutabaNAGP1250::drawGraphicLines(bitmap, SIZE, SIZE, {{CENTER, CENTER, angle, length}});
+
+            // A walk with as many pixels as the one to (x1, y1) that reaches it ends there: it is
+            // the only pixel that far from the start. Count the pixels and clear them.
+            const bool reached = bitmap[y1 * SIZE + x1];
+            uint32_t pixels = 0;
+            for (int16_t y = min(y1, CENTER) - 1; y <= max(y1, CENTER) + 1; ++y) {
+                for (int16_t x = min(x1, CENTER) - 1; x <= max(x1, CENTER) + 1; ++x) {
+                    pixels += bitmap[y * SIZE + x];
+                    bitmap[y * SIZE + x] = 0;
+                }
+            }
+            ++cases;
+            if (reached && pixels == max(abs(x1 - CENTER), abs(y1 - CENTER)) + 1u) continue;
+            ++moved;
+            const double exactX = cos(angle * (M_PI / 180)) * (length - 1);
+            const double exactY = sin(angle * (M_PI / 180)) * (length - 1);
+            const double tieX = fabs(exactX - floor(exactX) - 0.5);
+            const double tieY = fabs(exactY - floor(exactY) - 0.5);
+            wrong += min(tieX, tieY) >= 1.0 / 64;
+        }
+    }
+    CHECK(wrong == 0);
+    CHECK(moved * 100 < cases);
+}
+
+// ---------------------------------------------------------------------------------------
+// Emulator
+// ---------------------------------------------------------------------------------------
+
+// Pixels where the emulated display differs from `frame`, which covers the screen columns from
+// its origin on.
+uint32_t screenMismatches(const FutabaNAGP1250Emulator& emulator, const FutabaNAGP1250Framebuffer& frame) {
+    uint32_t mismatches = 0;
+    for (uint16_t y = 0; y < frame.height(); ++y) {
+        for (uint16_t x = frame.originX(); x < frame.originX() + frame.width(); ++x) {
+            mismatches += emulator.pixel(x, y) != frame.getPixel(x, y);
+        }
+    }
+    return mismatches;
+}
+
+// After every flush() the emulated display RAM holds exactly the framebuffer, however the
+// dirty regions were shaped and whether or not the flush was batched.
+void testEmulatorMatchesFramebufferAfterFlush() {
+    Random random(5);
+    FutabaNAGP1250Emulator emulator;
+    FutabaNAGP1250EmulatorTransport transport(emulator, 4000000);
+    FutabaNAGP1250 vfd(transport);
+    vfd.begin();
+    FutabaNAGP1250Framebuffer frame(140, 32);
+    FutabaNAGP1250TextRenderer text;
+    static const uint8_t sprite[16] = {0x3C, 0x42, 0x81, 0xA5, 0x81, 0x99, 0x42, 0x3C,
+                                       0xFF, 0x00, 0xFF, 0x00, 0xF0, 0x0F, 0xAA, 0x55};
+
+    uint32_t mismatches = 0;
+    for (uint16_t i = 0; i < 1000; ++i) {
+        for (uint8_t edits = 1 + random.below(3); edits; --edits) {
+            const int16_t x = static_cast<int16_t>(random.below(160)) - 10;
+            const int16_t y = static_cast<int16_t>(random.below(40)) - 4;
+            switch (random.below(7)) {
+                case 0:
+                    frame.setPixel(x, y, random.below(2));
+                    break;
+                case 1:
+                    frame.fillRect(x, y, random.below(60), random.below(20), random.below(2));
+                    break;
+                case 2:
+                    FutabaNAGP1250::drawGraphicLine(frame, random.below(140), random.below(32), random.below(140),
+                                                    random.below(32));
+                    break;
+                case 3:
+                    FutabaNAGP1250::drawGraphicCircle(frame, random.below(140), random.below(32), 1 + random.below(15));
+                    break;
+                case 4:
+                    text.drawText(frame, x, y, random.below(2) ? "Flush 42" : "ab", random.below(2));
+                    break;
+                case 5:
+                    FutabaNAGP1250::drawSprite(frame, sprite, 8, 16, x, y,
+                                               random.below(2) ? FutabaNAGP1250::WRITE_MODE_OR
+                                                               : FutabaNAGP1250::WRITE_MODE_XOR);
+                    break;
+                default:
+                    frame.clear();
+                    break;
+            }
+        }
+        if (random.below(4) == 0) {
+            FutabaNAGP1250::Batch batch(vfd);
+            vfd.flush(frame);
+        } else {
+            vfd.flush(frame);
+        }
+        mismatches += screenMismatches(emulator, frame);
+        for (uint8_t row = 0; row < frame.byteRows(); ++row) {
+            uint16_t x0, x1;
+            CHECK(!frame.dirtySpan(row, x0, x1));
+        }
+    }
+    CHECK(mismatches == 0);
+    CHECK(emulator.overruns() == 0);
+}
+
+// A framebuffer narrower than the screen lands at its origin column and leaves the rest alone.
+void testEmulatorFlushAtOrigin() {
+    Random random(9);
+    FutabaNAGP1250Emulator emulator;
+    FutabaNAGP1250EmulatorTransport transport(emulator, 4000000);
+    FutabaNAGP1250 vfd(transport);
+    vfd.begin();
+    FutabaNAGP1250Framebuffer background(140, 32);
+    background.fillRect(0, 0, 140, 32, true);
+    vfd.flush(background);
+
+    FutabaNAGP1250Framebuffer panel(40, 32);
+    panel.setOrigin(60);
+    uint32_t mismatches = 0;
+    for (uint16_t i = 0; i < 200; ++i) {
+        // Drawing happens in screen coordinates; the part outside the panel is clipped.
+        panel.fillRect(static_cast<int16_t>(random.below(140)), random.below(32), random.below(30), random.below(10),
+                       random.below(2));
+        vfd.flush(panel);
+        mismatches += screenMismatches(emulator, panel);
+        for (uint16_t y = 0; y < 32; ++y) {
+            for (uint16_t x = 0; x < 140; ++x) {
+                mismatches += (x < 60 || x >= 100) && !emulator.pixel(x, y);
+            }
+        }
+    }
+    CHECK(mismatches == 0);
+}
+
+// Switching the gray scheduler between full-frame and partial uploads never leaves the display
+// behind the plane it was meant to show.
+void testGrayUploadModesStayInStep() {
+    Random random(13);
+    FutabaNAGP1250Emulator emulator;
+    FutabaNAGP1250EmulatorTransport transport(emulator, 4000000);
+    FutabaNAGP1250 vfd(transport);
+    vfd.begin();
+    // With one bit per pixel every slot shows plane 0.
+    FutabaNAGP1250GrayCanvas canvas(140, 32, 1);
+    FutabaNAGP1250GrayScheduler scheduler(vfd, canvas);
+    scheduler.setSlotTime(1);
+
+    uint32_t mismatches = 0;
+    for (uint16_t i = 0; i < 300; ++i) {
+        // A box filled while full frames are sent, then filled the other way once partial
+        // uploads resume.
+        const bool full = i % 3 == 1;
+        scheduler.setPartialUploads(!full);
+        const int16_t x = static_cast<int16_t>(random.below(140));
+        const uint8_t y = random.below(32);
+        const uint16_t w = 1 + random.below(40);
+        const uint16_t h = 1 + random.below(16);
+        const bool on = !canvas.getPixel(x, y);
+        canvas.fillRect(x, y, w, h, on);
+        while (!scheduler.service()) {
+        }
+        mismatches += screenMismatches(emulator, canvas.plane(0));
+        if (full) {
+            scheduler.setPartialUploads(true);
+            canvas.fillRect(x, y, w, h, !on);
+            while (!scheduler.service()) {
+            }
+            mismatches += screenMismatches(emulator, canvas.plane(0));
+        }
+    }
+    CHECK(mismatches == 0);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc > 1) {
+        filter = argv[1];
+    }
+    test("service: every message once, per-producer order", testServiceDeliversEveryMessageOnceInOrder);
+    test("service: full ring refuses, then recovers", testServiceBackpressure);
+    test("service: tryPost against a busy consumer", testServiceTryPostUnderContention);
+    test("codec: round trip into a framebuffer", testCodecRoundTripIntoFramebuffer);
+    test("codec: round trip to the display", testCodecRoundTripToDisplay);
+    test("codec: fuzzed streams", testCodecFuzz);
+    test("codec: mismatched frame sizes are skipped", testCodecRejectsMismatchedFrames);
+    test("packing: block kernels match per-pixel packing", testPackingMatchesReference);
+    test("lines: long and off-screen segments are clipped exactly", testLinesClipLongSegments);
+    test("lines: angle end points match the floating-point formula", testLinesAngleEndpoints);
+    test("emulator: display RAM matches the framebuffer after flush", testEmulatorMatchesFramebufferAfterFlush);
+    test("emulator: flush places a narrow buffer at its origin", testEmulatorFlushAtOrigin);
+    test("grayscale: partial uploads resume after full frames", testGrayUploadModesStayInStep);
+    if (failedTests) {
+        printf("%d test(s) failed\n", failedTests);
+        return 1;
+    }
+    return 0;
+}
@@ -1,41 +1,142 @@
 #include "FutabaNAGP1250.h"
 
 #include <math.h>
+#include <new>
 
 // Define PI if not defined (Arduino usually defines PI)
 #ifndef PI
 #define PI 3.14159265358979323846f
 #endif
 
+// Link statistics (see FutabaNAGP1250Stats.h). Only this file reads the flag; the transport is
+// handed the counters only when it is set.
+#ifndef FUTABA_NAGP1250_STATS
+#define FUTABA_NAGP1250_STATS 0
+#endif
+
+// Size of the built-in transmit buffer that batches are encoded into. A batch that outgrows it
+// is sent in several transactions; setTransmitBuffer() can supply a larger one instead. This is
+// a build flag for the library (e.g. in build_flags), not something a sketch defines before
+// including the header: the buffer is allocated here, so the class layout does not depend on it.
+#ifndef FUTABA_NAGP1250_TX_BUFFER_SIZE
+#ifdef __AVR__
+#define FUTABA_NAGP1250_TX_BUFFER_SIZE 32
+#else
+#define FUTABA_NAGP1250_TX_BUFFER_SIZE 256
+#endif
+#endif
+
+static_assert(FUTABA_NAGP1250_TX_BUFFER_SIZE > 0, "FUTABA_NAGP1250_TX_BUFFER_SIZE must be positive");
+
+namespace {
+
+// Attributes a command buffer to a statistics bucket by its leading bytes.
+FutabaNAGP1250Stats::Command classifyCommand(const uint8_t* data, size_t length) {
+    if (!data || !length) {
+        return FutabaNAGP1250Stats::COMMAND_OTHER;
+    }
+    if (data[0] >= 0x20) {
+        return FutabaNAGP1250Stats::COMMAND_TEXT;
+    }
+    if (data[0] != 0x1F || length < 2) {
+        return FutabaNAGP1250Stats::COMMAND_OTHER;
+    }
+    if (data[1] == 0x24) {
+        return FutabaNAGP1250Stats::COMMAND_CURSOR;
+    }
+    if (data[1] != 0x28 || length < 3) {
+        return FutabaNAGP1250Stats::COMMAND_OTHER;
+    }
+    switch (data[2]) {
+        case 0x66: return FutabaNAGP1250Stats::COMMAND_IMAGE;
+        case 0x77: return FutabaNAGP1250Stats::COMMAND_WINDOW;
+        case 0x61: return FutabaNAGP1250Stats::COMMAND_ACTION;
+        default: return FutabaNAGP1250Stats::COMMAND_OTHER;
+    }
+}
+
+} // namespace
+
 
 FutabaNAGP1250::FutabaNAGP1250(SPIClass& spiPort,
                                int8_t resetPin,
                                int8_t sbusyPin,
                                uint32_t spiFrequency,
                                bool debug)
-    : spi_(spiPort),
-      spiSettings_(spiFrequency, LSBFIRST, SPI_MODE0),
+    : transport_(nullptr),
+      resetPin_(resetPin),
+      debug_(debug),
+      width_(WIDTH_BASE),
+      height_(HEIGHT),
+      txStorage_(FUTABA_NAGP1250_TX_BUFFER_SIZE),
+      txBuffer_(txStorage_.data()),
+      txCapacity_(txStorage_.size()),
+      txLength_(0),
+      batchDepth_(0),
+      async_(),
+      servicing_(false),
+      servicePending_(false),
+      interruptService_(false),
+      initializeCount_(0),
+      shadowing_(true),
+      suppressedBytes_(0) {
+    // The flow-control strategy is picked once here instead of being re-checked for every byte.
+    const FutabaNAGP1250SpiBus bus(spiPort, spiFrequency);
+    if (sbusyPin >= 0) {
+        transport_ = new (defaultTransport_) FutabaNAGP1250SpiSbusyTransport(bus, FutabaNAGP1250SbusyFlow(sbusyPin));
+    } else {
+        transport_ = new (defaultTransport_) FutabaNAGP1250SpiTimedTransport(bus, FutabaNAGP1250TimedFlow());
+    }
+#if FUTABA_NAGP1250_STATS
+    transport_->setStats(&stats_);
+#endif
+    invalidateState();
+}
+
+FutabaNAGP1250::FutabaNAGP1250(FutabaNAGP1250Transport& transport,
+                               int8_t resetPin,
+                               bool debug)
+    : transport_(&transport),
       resetPin_(resetPin),
-      sbusyPin_(sbusyPin),
       debug_(debug),
       width_(WIDTH_BASE),
-      height_(HEIGHT) {}
+      height_(HEIGHT),
+      txStorage_(FUTABA_NAGP1250_TX_BUFFER_SIZE),
+      txBuffer_(txStorage_.data()),
+      txCapacity_(txStorage_.size()),
+      txLength_(0),
+      batchDepth_(0),
+      async_(),
+      servicing_(false),
+      servicePending_(false),
+      interruptService_(false),
+      initializeCount_(0),
+      shadowing_(true),
+      suppressedBytes_(0) {
+#if FUTABA_NAGP1250_STATS
+    transport_->setStats(&stats_);
+#endif
+    invalidateState();
+}
+
+FutabaNAGP1250::~FutabaNAGP1250() {
+    // Only the transport built in defaultTransport_ belongs to the driver.
+    if (transport_ == reinterpret_cast<FutabaNAGP1250Transport*>(defaultTransport_)) {
+        transport_->~FutabaNAGP1250Transport();
+    }
+}
 
 bool FutabaNAGP1250::begin(uint8_t baseWindowMode,
                            uint8_t luminanceLevel,
                            int8_t cursorBlink,
                            uint8_t fontId,
                            uint8_t characterCode) {
-    spi_.begin();
+    transport_->begin();
 
     if (resetPin_ >= 0) {
         pinMode(resetPin_, OUTPUT);
     }
 
-    if (sbusyPin_ >= 0) {
-        pinMode(sbusyPin_, INPUT);
-    }
-
     resetDisplay();
     initialize();
     defineBaseWindow(baseWindowMode);
@@ -50,10 +151,13 @@ bool FutabaNAGP1250::begin(uint8_t baseWindowMode,
     return true;
 }
 
-void FutabaNAGP1250::resetDisplay() const {
+void FutabaNAGP1250::resetDisplay() {
     if (resetPin_ < 0) {
         return;
     }
+    invalidateState();
+    // A hardware reset loses the download characters just like ESC @.
+    ++initializeCount_;
 
     digitalWrite(resetPin_, HIGH);
     delay(1);
@@ -65,15 +169,41 @@ void FutabaNAGP1250::resetDisplay() const {
 
 void FutabaNAGP1250::initialize() {
     sendBytes({0x1B, 0x40});
+    ++initializeCount_;
+    invalidateState();
+}
+
+void FutabaNAGP1250::setStateShadowing(bool enabled) {
+    shadowing_ = enabled;
+    invalidateState();
+}
+
+void FutabaNAGP1250::invalidateState() {
+    memset(&shadow_, ShadowState::UNKNOWN, sizeof(shadow_));
+}
+
+bool FutabaNAGP1250::redundant(uint8_t& field, uint8_t value, uint8_t commandLength) {
+    if (shadowing_ && field == value) {
+        suppressedBytes_ += commandLength;
+        return true;
+    }
+    field = value;
+    return false;
 }
 
 void FutabaNAGP1250::setLuminance(uint8_t level) {
     level = constrain(level, static_cast<uint8_t>(1), static_cast<uint8_t>(8));
+    if (redundant(shadow_.luminance, level, 3)) {
+        return;
+    }
     sendBytes({0x1F, 0x58, level});
 }
 
 void FutabaNAGP1250::setCursorBlink(uint8_t mode) {
     mode = constrain(mode, static_cast<uint8_t>(0), static_cast<uint8_t>(1));
+    if (redundant(shadow_.cursorBlink, mode, 3)) {
+        return;
+    }
     sendBytes({0x1F, 0x43, mode});
 }
 
@@ -81,12 +211,15 @@ void FutabaNAGP1250::setCursorPosition(uint16_t x, uint16_t y) {
     if (x > 255 || y > 3) {
         return;
     }
-    sendBytes({0x1F, 0x24, static_cast<uint16_t>(x & 0xFF), static_cast<uint16_t>((x >> 8) & 0xFF),
-               static_cast<uint16_t>(y & 0xFF), static_cast<uint16_t>((y >> 8) & 0xFF)});
+    sendBytes({0x1F, 0x24, static_cast<uint8_t>(x & 0xFF), static_cast<uint8_t>((x >> 8) & 0xFF),
+               static_cast<uint8_t>(y & 0xFF), static_cast<uint8_t>((y >> 8) & 0xFF)});
 }
 
 void FutabaNAGP1250::setWriteLogic(uint8_t mode) {
     mode = constrain(mode, static_cast<uint8_t>(0), static_cast<uint8_t>(3));
+    if (redundant(shadow_.writeLogic, mode, 3)) {
+        return;
+    }
     sendBytes({0x1F, 0x77, mode});
 }
 
@@ -106,7 +239,9 @@ void FutabaNAGP1250::clearWindow(uint8_t window) {
     if (window > 4) {
         return;
     }
-    sendBytes({0x1F, 0x28, 0x77, 0x01, window});
+    if (!redundant(shadow_.window, window, 5)) {
+        sendBytes({0x1F, 0x28, 0x77, 0x01, window});
+    }
     sendBytes({0x0C});
 }
 
@@ -121,41 +256,40 @@ void FutabaNAGP1250::writeText(const char* text) {
     if (!text) {
         return;
     }
-    std::vector<uint16_t> payload;
-    payload.reserve(strlen(text));
-    while (*text) {
-        payload.push_back(static_cast<uint8_t>(*text++));
-    }
-    sendBytes(payload.data(), payload.size());
+    sendBytes(reinterpret_cast<const uint8_t*>(text), strlen(text));
 }
 
 void FutabaNAGP1250::writeText(const String& text) {
-    std::vector<uint16_t> payload;
-    payload.reserve(text.length());
-    for (size_t i = 0; i < text.length(); ++i) {
-        payload.push_back(static_cast<uint8_t>(text[i]));
-    }
-    sendBytes(payload.data(), payload.size());
+    sendBytes(reinterpret_cast<const uint8_t*>(text.c_str()), text.length());
 }
 
 void FutabaNAGP1250::setFont(uint8_t fontId) {
-    if (fontId > 0x0D) {
+    if (fontId > 0x0D || redundant(shadow_.font, fontId, 3)) {
         return;
     }
     sendBytes({0x1B, 0x52, fontId});
 }
 
 void FutabaNAGP1250::setCharacterCode(uint8_t codePage) {
+    if (redundant(shadow_.characterCode, codePage, 3)) {
+        return;
+    }
     sendBytes({0x1B, 0x74, codePage});
 }
 
 void FutabaNAGP1250::setHorizontalScrollSpeed(uint8_t speed) {
     speed = constrain(speed, static_cast<uint8_t>(0), static_cast<uint8_t>(31));
+    if (redundant(shadow_.scrollSpeed, speed, 3)) {
+        return;
+    }
     sendBytes({0x1F, 0x73, speed});
 }
 
 void FutabaNAGP1250::setReverseDisplay(uint8_t mode) {
     mode = constrain(mode, static_cast<uint8_t>(0), static_cast<uint8_t>(1));
+    if (redundant(shadow_.reverse, mode, 3)) {
+        return;
+    }
     sendBytes({0x1F, 0x72, mode});
 }
 
@@ -187,7 +321,7 @@ void FutabaNAGP1250::wait(uint8_t duration) {
 }
 
 void FutabaNAGP1250::selectWindow(uint8_t windowNum) {
-    if (windowNum > 4) return;
+    if (windowNum > 4 || redundant(shadow_.window, windowNum, 5)) return;
     sendBytes({0x1F, 0x28, 0x77, 0x01, windowNum});
 }
 
@@ -208,30 +342,26 @@ void FutabaNAGP1250::displayScroll(uint16_t shiftBytes, uint16_t repeatCount, ui
     uint8_t cl = repeatCount & 0xFF;
     uint8_t ch = (repeatCount >> 8) & 0xFF;
 
-    std::vector<uint16_t> payload = {
-        0x1F, 0x28, 0x61, 0x10,
-        static_cast<uint16_t>(wl), static_cast<uint16_t>(wh),
-        static_cast<uint16_t>(cl), static_cast<uint16_t>(ch),
-        static_cast<uint16_t>(speed)
-    };
-    sendBytes(payload.data(), payload.size(), true);
+    sendBytes({0x1F, 0x28, 0x61, 0x10, wl, wh, cl, ch, speed}, true);
 }
 
 void FutabaNAGP1250::defineUserWindow(uint8_t windowNum, uint16_t x, uint16_t y, uint16_t w, uint16_t h) {
     if (windowNum < 1 || windowNum > 4) return;
     if (x > 279 || y > 3) return;
     if (w < 1 || w > 280 || h < 1 || h > 4) return;
+    if (shadow_.window == windowNum) {
+        shadow_.window = ShadowState::UNKNOWN; // redefining the selected window
+    }
 
-    std::vector<uint16_t> payload = {
+    sendBytes({
         0x1F, 0x28, 0x77, 0x02,
-        static_cast<uint16_t>(windowNum),
+        windowNum,
         0x01,
-        static_cast<uint16_t>(x & 0xFF), static_cast<uint16_t>((x >> 8) & 0xFF),
-        static_cast<uint16_t>(y & 0xFF), static_cast<uint16_t>((y >> 8) & 0xFF),
-        static_cast<uint16_t>(w & 0xFF), static_cast<uint16_t>((w >> 8) & 0xFF),
-        static_cast<uint16_t>(h & 0xFF), static_cast<uint16_t>((h >> 8) & 0xFF)
-    };
-    sendBytes(payload.data(), payload.size());
+        static_cast<uint8_t>(x & 0xFF), static_cast<uint8_t>((x >> 8) & 0xFF),
+        static_cast<uint8_t>(y & 0xFF), static_cast<uint8_t>((y >> 8) & 0xFF),
+        static_cast<uint8_t>(w & 0xFF), static_cast<uint8_t>((w >> 8) & 0xFF),
+        static_cast<uint8_t>(h & 0xFF), static_cast<uint8_t>((h >> 8) & 0xFF)
+    });
 }
 
 void FutabaNAGP1250::deleteUserWindow(uint8_t windowNum, bool clear) {
@@ -239,73 +369,374 @@ void FutabaNAGP1250::deleteUserWindow(uint8_t windowNum, bool clear) {
     if (clear) {
         clearWindow(windowNum);
     }
-    sendBytes({0x1F, 0x28, 0x77, 0x02, static_cast<uint16_t>(windowNum), 0x00});
+    if (shadow_.window == windowNum) {
+        shadow_.window = ShadowState::UNKNOWN; // the module falls back to another window
+    }
+    sendBytes({0x1F, 0x28, 0x77, 0x02, windowNum, 0x00});
 }
 
 void FutabaNAGP1250::setFontMagnification(uint8_t h, uint8_t v) {
     if (h < 1 || h > 4 || v < 1 || v > 4) return;
+    if (redundant(shadow_.magnification, static_cast<uint8_t>(h << 4 | v), 6)) return;
     sendBytes({0x1F, 0x28, 0x67, 0x40, h, v});
 }
 
 void FutabaNAGP1250::setCharacterSpacing(uint8_t mode) {
-    if (mode > 3) return;
+    if (mode > 3 || redundant(shadow_.characterSpacing, mode, 5)) return;
     sendBytes({0x1F, 0x28, 0x67, 0x03, mode});
 }
 
+void FutabaNAGP1250::setDownloadCharacters(bool enabled) {
+    sendBytes({0x1B, 0x25, static_cast<uint8_t>(enabled ? 0x01 : 0x00)});
+}
+
+void FutabaNAGP1250::defineDownloadCharacter(uint8_t code, const uint8_t* columns, uint8_t width) {
+    if (!columns || code < 0x20 || width < 1 || width > DOWNLOAD_CHARACTER_WIDTH) {
+        return;
+    }
+    // ESC & a c1 c2 x d1..dx, one 5x7 character (a = 1) from c1 to c2.
+    uint8_t command[6 + DOWNLOAD_CHARACTER_WIDTH] = {0x1B, 0x26, 0x01, code, code, width};
+    memcpy(command + 6, columns, width);
+    sendBytes(command, 6 + width);
+}
+
+void FutabaNAGP1250::deleteDownloadCharacter(uint8_t code) {
+    if (code < 0x20) {
+        return;
+    }
+    sendBytes({0x1B, 0x3F, 0x01, code});
+}
 
 void FutabaNAGP1250::displayGraphicImage(const std::vector<uint8_t>& image,
                                          uint16_t width,
                                          uint16_t height) {
-    if (width == 0 || width > WIDTH_EXTENDED) {
+    if (height == 0 || (height % 8) != 0) {
         return;
     }
-    if (height == 0 || height > HEIGHT || (height % 8) != 0) {
+    if (image.size() != static_cast<size_t>(width * (height / 8))) {
         return;
     }
+    sendGraphicImage(image.data(), width, height / 8);
+}
 
-    const uint16_t byteRows = height / 8;
-    if (image.size() != static_cast<size_t>(width * byteRows)) {
+void FutabaNAGP1250::displayGraphicImage(const uint8_t* image, uint16_t width, uint16_t height) {
+    if (!image || height == 0 || (height % 8) != 0) {
         return;
     }
+    sendGraphicImage(image, width, height / 8);
+}
 
-    std::vector<uint16_t> header = {
-        0x1F,
-        0x28,
-        0x66,
-        0x11,
-        static_cast<uint16_t>(width & 0xFF),
-        static_cast<uint16_t>((width >> 8) & 0xFF),
-        static_cast<uint16_t>(byteRows & 0xFF),
-        static_cast<uint16_t>((byteRows >> 8) & 0xFF),
-        0x01,
+void FutabaNAGP1250::displayGraphicImage(const FutabaNAGP1250Framebuffer& framebuffer) {
+    sendGraphicImage(framebuffer.data(), framebuffer.width(), framebuffer.byteRows());
+}
+
+void FutabaNAGP1250::flush(FutabaNAGP1250Framebuffer& framebuffer) {
+    // Every sub-image costs a cursor command plus a bit image header on top of its payload.
+    constexpr uint16_t kRegionOverhead = 6 + 9;
+    const uint8_t byteRows = framebuffer.byteRows();
+
+    uint16_t spanX0[HEIGHT / 8];
+    uint16_t spanX1[HEIGHT / 8];
+    bool dirty[HEIGHT / 8];
+    for (uint8_t row = 0; row < byteRows; ++row) {
+        dirty[row] = framebuffer.dirtySpan(row, spanX0[row], spanX1[row]);
+    }
+
+    struct Region {
+        uint16_t x0, x1;
+        uint8_t r0, r1;
+    };
+    // Bounding box of the dirty rows in [first, last]; returns false if none are dirty.
+    auto bounds = [&](uint8_t first, uint8_t last, Region& region) {
+        region = {UINT16_MAX, 0, UINT8_MAX, 0};
+        for (uint8_t r = first; r <= last; ++r) {
+            if (!dirty[r]) continue;
+            region.x0 = min(region.x0, spanX0[r]);
+            region.x1 = max(region.x1, spanX1[r]);
+            region.r0 = min(region.r0, r);
+            region.r1 = r;
+        }
+        return region.r0 != UINT8_MAX;
+    };
+    auto groupEnds = [&](uint8_t splits, uint8_t row) {
+        return row == byteRows - 1 || (splits & (1 << row));
     };
 
-    // Perform a single SPI transaction for the entire packet (Header + Image)
-    // to ensure continuity and correct CS handling if managed externally.
-    spi_.beginTransaction(spiSettings_);
-    
-    // Send Header
-    for (uint16_t item : header) {
-        if (sbusyPin_ >= 0) {
-            while (digitalRead(sbusyPin_) == HIGH) {}
+    // Byte rows are grouped into vertically contiguous regions. With at most four byte rows
+    // there are only eight ways to split them, so pick the one that sends the fewest bytes.
+    uint8_t bestSplits = 0;
+    uint32_t bestCost = UINT32_MAX;
+    for (uint8_t splits = 0; splits < (1 << (byteRows - 1)); ++splits) {
+        uint32_t cost = 0;
+        Region region;
+        for (uint8_t row = 0, first = 0; row < byteRows; ++row) {
+            if (!groupEnds(splits, row)) continue;
+            if (bounds(first, row, region)) {
+                cost += kRegionOverhead + static_cast<uint32_t>(region.x1 - region.x0 + 1) * (region.r1 - region.r0 + 1);
+            }
+            first = row + 1;
+        }
+        if (cost < bestCost) {
+            bestCost = cost;
+            bestSplits = splits;
         }
-        spi_.transfer(static_cast<uint8_t>(item));
-        if (sbusyPin_ < 0) delayMicroseconds(400);
     }
 
-    // Send Image Data
-    for (uint8_t byte : image) {
-        if (sbusyPin_ >= 0) {
-            while (digitalRead(sbusyPin_) == HIGH) {}
+    Region region;
+    for (uint8_t row = 0, first = 0; row < byteRows; ++row) {
+        if (!groupEnds(bestSplits, row)) continue;
+        if (bounds(first, row, region)) {
+            setCursorPosition(framebuffer.originX() + region.x0, region.r0);
+            sendGraphicImage(framebuffer.data() + static_cast<size_t>(region.x0) * byteRows + region.r0,
+                             region.x1 - region.x0 + 1, region.r1 - region.r0 + 1, byteRows);
         }
-        spi_.transfer(byte);
-        if (sbusyPin_ < 0) delayMicroseconds(400);
+        first = row + 1;
     }
-    
-    spi_.endTransaction();
+
+    framebuffer.clearDirty();
+}
+
+void FutabaNAGP1250::sendGraphicImage(const uint8_t* image, uint16_t width, uint16_t byteRows, uint16_t stride) {
+    if (!image || width == 0 || width > WIDTH_EXTENDED) {
+        return;
+    }
+    if (byteRows == 0 || byteRows > HEIGHT / 8) {
+        return;
+    }
+    if (stride < byteRows) {
+        stride = byteRows;
+    }
+    if (async_.active) {
+        finishAsync();
+    }
+
+    uint8_t header[9];
+    const uint8_t headerLength = encodeGraphicImageHeader(header, width, byteRows);
+
+    if (batchDepth_) {
+        countBytes(FutabaNAGP1250Stats::COMMAND_IMAGE, headerLength + static_cast<size_t>(width) * byteRows);
+        appendBatch(header, 1, headerLength, headerLength);
+        appendBatch(image, width, byteRows, stride);
+        return;
+    }
+
+    // Perform a single SPI transaction for the entire packet (Header + Image)
+    // to ensure continuity and correct CS handling if managed externally.
+    countBytes(FutabaNAGP1250Stats::COMMAND_IMAGE, headerLength + static_cast<size_t>(width) * byteRows);
+    beginTransaction();
+    transport_->write(header, headerLength);
+    // Image data is `width` columns of `byteRows` bytes, `stride` bytes apart in the source.
+    transport_->write(image, width, byteRows, stride);
+    transport_->endTransaction();
     waitForBusy();
 }
 
+void FutabaNAGP1250::beginGraphicImageStream(uint16_t width, uint8_t byteRows) {
+    if (width == 0 || width > WIDTH_EXTENDED || byteRows == 0 || byteRows > HEIGHT / 8) {
+        return;
+    }
+    uint8_t header[9];
+    const uint8_t headerLength = encodeGraphicImageHeader(header, width, byteRows);
+    sendBytes(header, headerLength, false);
+}
+
+void FutabaNAGP1250::writeGraphicImageStream(const uint8_t* data, size_t length) {
+    sendBytes(data, length, false, FutabaNAGP1250Stats::COMMAND_IMAGE);
+}
+
+void FutabaNAGP1250::endGraphicImageStream() {
+    if (!batchDepth_) {
+        waitForBusy();
+    }
+}
+
+uint8_t FutabaNAGP1250::encodeGraphicImageHeader(uint8_t* out, uint16_t width, uint16_t byteRows) {
+    out[0] = 0x1F;
+    out[1] = 0x28;
+    out[2] = 0x66;
+    out[3] = 0x11;
+    out[4] = width & 0xFF;
+    out[5] = (width >> 8) & 0xFF;
+    out[6] = byteRows & 0xFF;
+    out[7] = (byteRows >> 8) & 0xFF;
+    out[8] = 0x01;
+    return 9;
+}
+
+bool FutabaNAGP1250::displayGraphicImageAsync(const FutabaNAGP1250Framebuffer& framebuffer,
+                                              CompletionCallback callback,
+                                              void* context) {
+    if (async_.active || batchDepth_) {
+        return false;
+    }
+    AsyncTransfer transfer = AsyncTransfer();
+    transfer.headerLength = encodeGraphicImageHeader(transfer.header, framebuffer.width(), framebuffer.byteRows());
+    transfer.payload = framebuffer.data();
+    transfer.payloadLength = framebuffer.size();
+    transfer.callback = callback;
+    transfer.context = context;
+    countBytes(FutabaNAGP1250Stats::COMMAND_IMAGE, transfer.headerLength + transfer.payloadLength);
+    startAsync(transfer);
+    return true;
+}
+
+bool FutabaNAGP1250::sendAsync(const uint8_t* data, size_t length,
+                               CompletionCallback callback,
+                               void* context) {
+    if (async_.active || batchDepth_ || !data || !length) {
+        return false;
+    }
+    AsyncTransfer transfer = AsyncTransfer();
+    transfer.payload = data;
+    transfer.payloadLength = length;
+    transfer.callback = callback;
+    transfer.context = context;
+    countBytes(classifyCommand(data, length), length);
+    invalidateState();
+    startAsync(transfer);
+    return true;
+}
+
+void FutabaNAGP1250::startAsync(const AsyncTransfer& transfer) {
+    // The SBUSY interrupt may call service() at any time; it must not see a half-written transfer.
+    noInterrupts();
+    async_ = transfer;
+    async_.active = true;
+    interrupts();
+    // When edges resume the transfer, the first burst must run until SBUSY rises, or no edge
+    // would ever follow.
+    service(interruptService_ ? SIZE_MAX : 64);
+}
+
+void FutabaNAGP1250::setServiceFromInterrupt(bool enabled) {
+    interruptService_ = enabled;
+    transport_->setReadyCallback(enabled ? &FutabaNAGP1250::serviceFromInterrupt : nullptr, this);
+}
+
+void FutabaNAGP1250::serviceFromInterrupt(void* context) {
+    static_cast<FutabaNAGP1250*>(context)->service(SIZE_MAX);
+}
+
+bool FutabaNAGP1250::service(size_t maxBytes) {
+    if (!async_.active) {
+        return false;
+    }
+    // servicing_ keeps the SBUSY interrupt out while the loop is already pumping (and vice versa).
+    // An edge that arrives meanwhile is remembered in servicePending_ and the running pump goes
+    // round again, or the display would sit idle with no further edge to resume the transfer.
+    if (servicing_) {
+        servicePending_ = true;
+        return true;
+    }
+    size_t budget = maxBytes;
+    do {
+        servicing_ = true;
+        servicePending_ = false;
+
+        // Only hand over what the display can take right now; the transport returns as soon as
+        // SBUSY is asserted (or, without SBUSY, while the byte spacing has not elapsed).
+        beginTransaction();
+        if (async_.headerSent < async_.headerLength && budget) {
+            const size_t sent = transport_->writeAvailable(async_.header + async_.headerSent,
+                                                           min(static_cast<size_t>(async_.headerLength - async_.headerSent), budget));
+            async_.headerSent += sent;
+            budget -= sent;
+        }
+        if (async_.headerSent == async_.headerLength && budget) {
+            const size_t sent = transport_->writeAvailable(async_.payload + async_.payloadSent,
+                                                           min(async_.payloadLength - async_.payloadSent, budget));
+            async_.payloadSent += sent;
+        }
+        transport_->endTransaction();
+
+        if (async_.headerSent == async_.headerLength && async_.payloadSent == async_.payloadLength) {
+            async_.active = false;
+        }
+        servicing_ = false;
+        // A pending edge means the display became ready again: pump until SBUSY rises.
+        budget = SIZE_MAX;
+    } while (servicePending_ && async_.active);
+
+    if (!async_.active && async_.callback) {
+        const CompletionCallback callback = async_.callback;
+        async_.callback = nullptr;
+        callback(async_.context);
+    }
+    return async_.active;
+}
+
+void FutabaNAGP1250::finishAsync() {
+    while (service(SIZE_MAX)) {
+        yield();
+    }
+}
+
+namespace {
+
+// Transposes an 8x8 bit block. `rows[r]` holds pixel row r with the leftmost pixel in the MSB;
+// column c is written to `out[c * stride]` with the top pixel in the MSB, which is the display's
+// column-major byte. Only the first `columns` columns are stored. (Hacker's Delight, transpose8.)
+inline void transpose8x8(const uint8_t rows[8], uint8_t* out, size_t stride, uint8_t columns) {
+    uint32_t x = (static_cast<uint32_t>(rows[0]) << 24) | (static_cast<uint32_t>(rows[1]) << 16) |
+                 (static_cast<uint32_t>(rows[2]) << 8) | rows[3];
+    uint32_t y = (static_cast<uint32_t>(rows[4]) << 24) | (static_cast<uint32_t>(rows[5]) << 16) |
+                 (static_cast<uint32_t>(rows[6]) << 8) | rows[7];
+    uint32_t t;
+
+    t = (x ^ (x >> 7)) & 0x00AA00AAUL;
+    x = x ^ t ^ (t << 7);
+    t = (y ^ (y >> 7)) & 0x00AA00AAUL;
+    y = y ^ t ^ (t << 7);
+
+    t = (x ^ (x >> 14)) & 0x0000CCCCUL;
+    x = x ^ t ^ (t << 14);
+    t = (y ^ (y >> 14)) & 0x0000CCCCUL;
+    y = y ^ t ^ (t << 14);
+
+    t = (x & 0xF0F0F0F0UL) | ((y >> 4) & 0x0F0F0F0FUL);
+    y = ((x << 4) & 0xF0F0F0F0UL) | (y & 0x0F0F0F0FUL);
+    x = t;
+
+    const uint8_t columnBytes[8] = {
+        static_cast<uint8_t>(x >> 24), static_cast<uint8_t>(x >> 16),
+        static_cast<uint8_t>(x >> 8), static_cast<uint8_t>(x),
+        static_cast<uint8_t>(y >> 24), static_cast<uint8_t>(y >> 16),
+        static_cast<uint8_t>(y >> 8), static_cast<uint8_t>(y),
+    };
+    for (uint8_t c = 0; c < columns; ++c) {
+        out[c * stride] = columnBytes[c];
+    }
+}
+
+// Packs 8 byte-per-pixel values (any nonzero byte is lit) into one row byte, leftmost in the MSB.
+inline uint8_t gatherPixels8(const uint8_t* pixels) {
+#if !defined(__AVR__) && defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    uint64_t v;
+    memcpy(&v, pixels, sizeof(v));
+    // Set bit 0 of every nonzero byte, then let one multiply move byte k's bit to bit 63 - k.
+    v = ((((v & 0x7F7F7F7F7F7F7F7FULL) + 0x7F7F7F7F7F7F7F7FULL) | v) >> 7) & 0x0101010101010101ULL;
+    return static_cast<uint8_t>((v * 0x8040201008040201ULL) >> 56);
+#else
+    return static_cast<uint8_t>(((pixels[0] != 0) << 7) | ((pixels[1] != 0) << 6) |
+                                ((pixels[2] != 0) << 5) | ((pixels[3] != 0) << 4) |
+                                ((pixels[4] != 0) << 3) | ((pixels[5] != 0) << 2) |
+                                ((pixels[6] != 0) << 1) | (pixels[7] != 0));
+#endif
+}
+
+inline uint8_t gatherPixels(const uint8_t* pixels, uint8_t count) {
+    if (count == 8) {
+        return gatherPixels8(pixels);
+    }
+    uint8_t byte = 0;
+    for (uint8_t i = 0; i < count; ++i) {
+        byte |= static_cast<uint8_t>((pixels[i] != 0) << (7 - i));
+    }
+    return byte;
+}
+
+} // namespace
+
 std::vector<uint8_t> FutabaNAGP1250::packBitmap(const std::vector<uint8_t>& bitmap,
                                                 uint16_t width,
                                                 uint16_t height) {
@@ -314,62 +745,234 @@ std::vector<uint8_t> FutabaNAGP1250::packBitmap(const std::vector<uint8_t>& bitm
         return packed;
     }
 
-    packed.reserve(static_cast<size_t>(width) * ((height + 7) / 8));
-    for (uint16_t x = 0; x < width; ++x) {
-        for (uint16_t row = 0; row < height; row += 8) {
-            uint8_t byte = 0;
-            for (uint8_t bit = 0; bit < 8 && (row + bit) < height; ++bit) {
-                const uint16_t index = (row + bit) * width + x;
-                if (bitmap[index]) {
-                    byte |= (1 << (7 - bit));
-                }
+    packed.resize(static_cast<size_t>(width) * ((height + 7) / 8));
+    packBitmap(bitmap.data(), width, height, packed.data());
+    return packed;
+}
+
+void FutabaNAGP1250::packBitmap(const uint8_t* bitmap, uint16_t width, uint16_t height, uint8_t* out) {
+    if (!bitmap || !out) {
+        return;
+    }
+    // Each 8x8 block is first gathered into eight row bytes, then transposed into eight columns.
+    const uint8_t byteRows = (height + 7) / 8;
+    uint8_t rows[8];
+    for (uint8_t band = 0; band < byteRows; ++band) {
+        const uint16_t y0 = band * 8;
+        const uint8_t bandHeight = min(static_cast<uint16_t>(8), static_cast<uint16_t>(height - y0));
+        for (uint16_t x = 0; x < width; x += 8) {
+            const uint8_t columns = min(static_cast<uint16_t>(8), static_cast<uint16_t>(width - x));
+            for (uint8_t r = 0; r < 8; ++r) {
+                rows[r] = r < bandHeight
+                    ? gatherPixels(bitmap + static_cast<size_t>(y0 + r) * width + x, columns)
+                    : 0;
             }
-            packed.push_back(byte);
+            transpose8x8(rows, out + static_cast<size_t>(x) * byteRows + band, byteRows, columns);
         }
     }
-    return packed;
 }
 
-void FutabaNAGP1250::drawGraphicLines(std::vector<uint8_t>& bitmap,
-                                      uint16_t width,
-                                      uint16_t height,
-                                      const std::vector<GraphicLine>& lines) {
-    for (const auto& line : lines) {
-        const float angleRad = line.angle_deg * DEG_TO_RAD;
-        const float degX = cosf(angleRad);
-        const float degY = -sinf(angleRad);
-        for (uint16_t i = 0; i < line.length; ++i) {
-            const int16_t x = static_cast<int16_t>(roundf(line.x + degX * i));
-            const int16_t y = static_cast<int16_t>(roundf(line.y + degY * i));
-            if (x >= 0 && x < static_cast<int16_t>(width) && y >= 0 && y < static_cast<int16_t>(height)) {
-                bitmap[y * width + x] = 1;
+void FutabaNAGP1250::packBitmap1bpp(const uint8_t* bits, uint16_t width, uint16_t height,
+                                    uint8_t* out, size_t rowStride) {
+    if (!bits || !out) {
+        return;
+    }
+    if (rowStride == 0) {
+        rowStride = (width + 7) / 8;
+    }
+    const uint8_t byteRows = (height + 7) / 8;
+    uint8_t rows[8];
+    for (uint8_t band = 0; band < byteRows; ++band) {
+        const uint16_t y0 = band * 8;
+        const uint8_t bandHeight = min(static_cast<uint16_t>(8), static_cast<uint16_t>(height - y0));
+        for (uint16_t x = 0; x < width; x += 8) {
+            const uint8_t columns = min(static_cast<uint16_t>(8), static_cast<uint16_t>(width - x));
+            const uint8_t* src = bits + static_cast<size_t>(y0) * rowStride + x / 8;
+            for (uint8_t r = 0; r < 8; ++r) {
+                rows[r] = r < bandHeight ? src[r * rowStride] : 0;
             }
+            transpose8x8(rows, out + static_cast<size_t>(x) * byteRows + band, byteRows, columns);
         }
     }
 }
 
-void FutabaNAGP1250::drawGraphicCircle(std::vector<uint8_t>& bitmap, 
-                                       uint16_t cx, uint16_t cy, uint16_t radius, 
-                                       uint16_t width, uint16_t height) {
+namespace {
+
+// The raster routines are shared by the legacy byte-per-pixel bitmaps and the packed
+// framebuffer. The target covers columns `left .. left + width - 1` (a framebuffer may show a
+// band of the screen, see setOrigin) and `plot` is only ever called with coordinates inside it.
+// sin(0..90 degrees) in Q15.
+const uint16_t kSineTable[91] PROGMEM = {
+    0, 572, 1144, 1715, 2286, 2856, 3425, 3993, 4560, 5126,
+    5690, 6252, 6813, 7371, 7927, 8481, 9032, 9580, 10126, 10668,
+    11207, 11743, 12275, 12803, 13328, 13848, 14365, 14876, 15384, 15886,
+    16384, 16877, 17364, 17847, 18324, 18795, 19261, 19720, 20174, 20622,
+    21063, 21498, 21926, 22348, 22763, 23170, 23571, 23965, 24351, 24730,
+    25102, 25466, 25822, 26170, 26510, 26842, 27166, 27482, 27789, 28088,
+    28378, 28660, 28932, 29197, 29452, 29698, 29935, 30163, 30382, 30592,
+    30792, 30983, 31164, 31336, 31499, 31651, 31795, 31928, 32052, 32166,
+    32270, 32365, 32449, 32524, 32588, 32643, 32688, 32723, 32748, 32763,
+    32768,
+};
+
+// sin(angle / 4096 degrees) in Q15, interpolated between whole degrees. The fine angle unit
+// keeps fractional angles such as 0.7 degrees from snapping to a coarser step.
+int32_t sineQ15(int32_t angle) {
+    constexpr int32_t DEGREE = 4096;
+    angle %= 360 * DEGREE;
+    if (angle < 0) angle += 360 * DEGREE;
+    const bool negative = angle >= 180 * DEGREE;
+    if (negative) angle -= 180 * DEGREE;
+    if (angle > 90 * DEGREE) angle = 180 * DEGREE - angle;
+
+    const uint8_t degree = angle / DEGREE;
+    const int32_t low = pgm_read_word(&kSineTable[degree]);
+    const int32_t high = degree < 90 ? pgm_read_word(&kSineTable[degree + 1]) : low;
+    const int32_t value = low + (((high - low) * (angle % DEGREE) + DEGREE / 2) / DEGREE);
+    return negative ? -value : value;
+}
+
+// Q15 product rounded to the nearest integer, halves away from zero like roundf().
+int32_t roundQ15(int32_t value) {
+    return value >= 0 ? (value + (1L << 14)) >> 15 : -((-value + (1L << 14)) >> 15);
+}
+
+// End point of an angle/length line: the last of its `length` pixels, i.e.
+// roundf(x + cos(angle) * (length - 1)) and roundf(y - sin(angle) * (length - 1)). The sine
+// table is accurate to about 4e-5, so the result only differs from the floating-point formula
+// when that lands within a hundredth of a pixel of a rounding tie (for lengths up to 256).
+// End points beyond the coordinate range are clamped to it.
+void lineEndpoint(const FutabaNAGP1250::GraphicLine& line, int16_t& x1, int16_t& y1) {
+    const int32_t angle = static_cast<int32_t>(lroundf(fmodf(line.angle_deg, 360) * 4096));
+    const int32_t steps = line.length - 1;
+    const int32_t x = line.x + roundQ15(sineQ15(angle + 90 * 4096) * steps);
+    const int32_t y = line.y - roundQ15(sineQ15(angle) * steps);
+    x1 = constrain(x, static_cast<int32_t>(INT16_MIN), static_cast<int32_t>(INT16_MAX));
+    y1 = constrain(y, static_cast<int32_t>(INT16_MIN), static_cast<int32_t>(INT16_MAX));
+}
+
+// Smallest integer not below a / b, for b > 0.
+int64_t ceilDiv(int64_t a, int64_t b) {
+    return a >= 0 ? (a + b - 1) / b : -(-a / b);
+}
+
+// Integer Bresenham from (x0, y0) to (x1, y1), both ends inclusive. Along the major axis,
+// step s lands on minor offset floor((major + 2 * minor * s) / (2 * major)), so the walk is
+// clipped to the target up front and starts at its first visible step instead of crossing
+// an arbitrarily long off-target stretch one pixel at a time.
+template <typename Plot>
+void rasterSegment(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                   int16_t left, uint16_t width, uint16_t height, Plot plot) {
+    const int32_t right = static_cast<int32_t>(left) + width;
+    // Segments entirely beside the target, e.g. outside a strip, cost nothing.
+    if ((x0 < left && x1 < left) || (x0 >= right && x1 >= right)) return;
+    if ((y0 < 0 && y1 < 0) || (y0 >= height && y1 >= height)) return;
+    const int32_t dx = abs(static_cast<int32_t>(x1) - x0);
+    const int32_t dy = abs(static_cast<int32_t>(y1) - y0);
+    if (dx == 0 && dy == 0) {
+        plot(x0, y0);
+        return;
+    }
+    const bool steep = dy > dx;
+    const int32_t major = steep ? dy : dx;
+    const int32_t minor = steep ? dx : dy;
+    const int32_t majorStart = steep ? y0 : x0;
+    const int32_t minorStart = steep ? x0 : y0;
+    const int8_t majorStep = (steep ? y0 < y1 : x0 < x1) ? 1 : -1;
+    const int8_t minorStep = (steep ? x0 < x1 : y0 < y1) ? 1 : -1;
+    const int32_t majorLow = steep ? 0 : left;
+    const int32_t majorHigh = (steep ? static_cast<int32_t>(height) : right) - 1;
+    const int32_t minorLow = steep ? left : 0;
+    const int32_t minorHigh = (steep ? right : static_cast<int32_t>(height)) - 1;
+
+    // Steps whose major coordinate lies inside the target.
+    int64_t first = majorStep > 0 ? majorLow - majorStart : majorStart - majorHigh;
+    int64_t last = majorStep > 0 ? majorHigh - majorStart : majorStart - majorLow;
+    // Steps whose minor offset lies inside it; the offset never decreases along the walk.
+    const int64_t offsetLow = minorStep > 0 ? minorLow - minorStart : minorStart - minorHigh;
+    const int64_t offsetHigh = minorStep > 0 ? minorHigh - minorStart : minorStart - minorLow;
+    if (minor == 0) {
+        if (offsetLow > 0 || offsetHigh < 0) return;
+    } else {
+        first = max(first, ceilDiv(2 * major * offsetLow - major, 2 * minor));
+        last = min(last, ceilDiv(2 * major * offsetHigh + major, 2 * minor) - 1);
+    }
+    first = max(first, static_cast<int64_t>(0));
+    last = min(last, static_cast<int64_t>(major));
+    if (first > last) return;
+
+    const int64_t numerator = major + 2LL * minor * first;
+    int32_t offset = static_cast<int32_t>(numerator / (2 * major));
+    int32_t error = static_cast<int32_t>(numerator % (2 * major));
+    int32_t position = majorStart + majorStep * static_cast<int32_t>(first);
+    for (int32_t step = static_cast<int32_t>(first); step <= last; ++step) {
+        const int16_t across = static_cast<int16_t>(minorStart + minorStep * offset);
+        if (steep) {
+            plot(across, static_cast<int16_t>(position));
+        } else {
+            plot(static_cast<int16_t>(position), across);
+        }
+        position += majorStep;
+        error += 2 * minor;
+        if (error >= 2 * major) {
+            error -= 2 * major;
+            ++offset;
+        }
+    }
+}
+
+// Drawing targets for the span-based routines. Spans have x0 <= x1 / y0 <= y1 (inclusive).
+// Bitmap coordinates must be inside the bitmap; the framebuffer target clips to its band.
+struct BitmapTarget {
+    std::vector<uint8_t>& bitmap;
+    uint16_t width;
+
+    void plot(int16_t x, int16_t y) { bitmap[y * width + x] = 1; }
+    void vspan(int16_t x, int16_t y0, int16_t y1) {
+        for (int16_t y = y0; y <= y1; ++y) bitmap[y * width + x] = 1;
+    }
+    void rect(int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+        for (int16_t y = y0; y <= y1; ++y) memset(&bitmap[y * width + x0], 1, x1 - x0 + 1);
+    }
+};
+
+struct FramebufferTarget {
+    FutabaNAGP1250Framebuffer& framebuffer;
+
+    void plot(int16_t x, int16_t y) { framebuffer.setPixel(x, y); }
+    void vspan(int16_t x, int16_t y0, int16_t y1) { framebuffer.drawVerticalLine(x, y0, y1 - y0 + 1); }
+    void rect(int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+        framebuffer.fillRect(x0, y0, x1 - x0 + 1, y1 - y0 + 1);
+    }
+};
+
+template <typename Plot>
+void rasterCircle(uint16_t cx, uint16_t cy, uint16_t radius,
+                  int16_t left, uint16_t width, uint16_t height, Plot plot) {
+    const int32_t right = static_cast<int32_t>(left) + width;
+    if (static_cast<int32_t>(cx) + radius < left || static_cast<int32_t>(cx) - radius >= right) return;
     int16_t x = radius;
     int16_t y = 0;
     int16_t d = 1 - radius;
 
-    auto plot = [&](int16_t px, int16_t py) {
-        if (px >= 0 && px < width && py >= 0 && py < height) {
-            bitmap[py * width + px] = 1;
+    // Circles entirely inside the target skip the per-pixel bounds checks.
+    const bool inside = static_cast<int32_t>(cx) - radius >= left && cy >= radius &&
+                        static_cast<int32_t>(cx) + radius < right && static_cast<int32_t>(cy) + radius < height;
+    auto clipped = [&](int16_t px, int16_t py) {
+        if (inside || (px >= left && px < right && py >= 0 && py < height)) {
+            plot(px, py);
         }
     };
 
     while (x >= y) {
-        plot(cx + x, cy + y);
-        plot(cx + y, cy + x);
-        plot(cx - y, cy + x);
-        plot(cx - x, cy + y);
-        plot(cx - x, cy - y);
-        plot(cx - y, cy - x);
-        plot(cx + y, cy - x);
-        plot(cx + x, cy - y);
+        clipped(cx + x, cy + y);
+        clipped(cx + y, cy + x);
+        clipped(cx - y, cy + x);
+        clipped(cx - x, cy + y);
+        clipped(cx - x, cy - y);
+        clipped(cx - y, cy - x);
+        clipped(cx + y, cy - x);
+        clipped(cx + x, cy - y);
         y++;
         if (d < 0) {
             d += 2 * y + 1;
@@ -380,29 +983,29 @@ void FutabaNAGP1250::drawGraphicCircle(std::vector<uint8_t>& bitmap,
     }
 }
 
-void FutabaNAGP1250::drawGraphicCircleFilled(std::vector<uint8_t>& bitmap, 
-                                             uint16_t cx, uint16_t cy, uint16_t radius, 
-                                             uint16_t width, uint16_t height) {
+// Filled circle as vertical spans: every midpoint step (x, y) covers the columns cx +/- x down to
+// +/- y rows and the columns cx +/- y down to +/- x rows. Each span is clipped once.
+template <typename Target>
+void rasterCircleFilled(uint16_t cx, uint16_t cy, uint16_t radius,
+                        int16_t left, uint16_t width, uint16_t height, Target& target) {
+    const int32_t right = static_cast<int32_t>(left) + width;
+    if (static_cast<int32_t>(cx) + radius < left || static_cast<int32_t>(cx) - radius >= right) return;
     int16_t x = radius;
     int16_t y = 0;
     int16_t d = 1 - radius;
 
-    auto drawSpan = [&](int16_t yOffset, int16_t xLeft, int16_t xRight) {
-        int16_t yPos = cy + yOffset;
-        if (yPos >= 0 && yPos < height) {
-            for (int16_t xPos = cx - xLeft; xPos <= cx + xRight; ++xPos) {
-                if (xPos >= 0 && xPos < width) {
-                    bitmap[yPos * width + xPos] = 1;
-                }
-            }
-        }
+    auto column = [&](int16_t px, int16_t halfHeight) {
+        if (px < left || px >= right) return;
+        const int16_t top = max(static_cast<int16_t>(cy - halfHeight), static_cast<int16_t>(0));
+        const int16_t bottom = min(static_cast<int16_t>(cy + halfHeight), static_cast<int16_t>(height - 1));
+        if (top <= bottom) target.vspan(px, top, bottom);
     };
 
     while (x >= y) {
-        drawSpan(y, x, x);
-        drawSpan(-y, x, x);
-        drawSpan(x, y, y);
-        drawSpan(-x, y, y);
+        column(cx - x, y);
+        column(cx + x, y);
+        column(cx - y, x);
+        column(cx + y, x);
         y++;
         if (d < 0) {
             d += 2 * y + 1;
@@ -413,168 +1016,409 @@ void FutabaNAGP1250::drawGraphicCircleFilled(std::vector<uint8_t>& bitmap,
     }
 }
 
-void FutabaNAGP1250::drawGraphicBox(std::vector<uint8_t>& bitmap, 
-                                    uint16_t x, uint16_t y, uint16_t w, uint16_t h, 
-                                    uint16_t bitmapWidth, uint16_t bitmapHeight,
-                                    uint16_t radius, bool fill) {
-    if (bitmap.size() < static_cast<size_t>(bitmapWidth * bitmapHeight)) return;
-
-    int16_t x0 = constrain(x, 0, bitmapWidth - 1);
-    int16_t x1 = constrain(x + w - 1, 0, bitmapWidth - 1);
-    int16_t y0 = constrain(y, 0, bitmapHeight - 1);
-    int16_t y1 = constrain(y + h - 1, 0, bitmapHeight - 1);
-    
-    int16_t actualW = x1 - x0;
-    int16_t actualH = y1 - y0;
+template <typename Target>
+void rasterBox(uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+               uint16_t bitmapWidth, uint16_t bitmapHeight,
+               uint16_t radius, bool fill, Target& target) {
+    // The box is clamped to the target once; everything below stays inside it.
+    const int16_t x0 = constrain(x, 0, bitmapWidth - 1);
+    const int16_t x1 = constrain(x + w - 1, 0, bitmapWidth - 1);
+    const int16_t y0 = constrain(y, 0, bitmapHeight - 1);
+    const int16_t y1 = constrain(y + h - 1, 0, bitmapHeight - 1);
+
+    const int16_t actualW = x1 - x0;
+    const int16_t actualH = y1 - y0;
     if (actualW < 0 || actualH < 0) return;
 
-    radius = constrain(radius, 0, min(actualW / 2, actualH / 2));
-    if (radius < 1) radius = 1; // Ensure at least minimal radius logic applies, though 0 is passed for sharp corners
     // Python logic: radius = max(1, min(radius, min((x1 - x0) // 2, (y1 - y0) // 2)))
-    // If radius passed is 0, logic should handle sharp box.
-    // Python logic forces radius to be at least 1.
-    radius = max(1, min(static_cast<int>(radius), min(actualW / 2, actualH / 2)));
+    // A radius of 1 still covers the corner pixel, i.e. it is a sharp box.
+    const int16_t r = max(1, min(static_cast<int>(radius), min(actualW / 2, actualH / 2)));
 
-    // Fill interior rectangle (excluding corners)
-    if (fill) {
-        for (int16_t yi = y0 + radius; yi <= y1 - radius; ++yi) {
-            for (int16_t xi = x0 + 1; xi < x1; ++xi) { // Python: range(x0 + 1, x1)
-                 if (yi >= 0 && yi < bitmapHeight && xi >= 0 && xi < bitmapWidth) bitmap[yi * bitmapWidth + xi] = 1;
-            }
+    if (r <= 1) {
+        if (fill) {
+            target.rect(x0, y0, x1, y1);
+        } else {
+            target.rect(x0, y0, x1, y0);
+            target.rect(x0, y1, x1, y1);
+            target.vspan(x0, y0, y1);
+            target.vspan(x1, y0, y1);
         }
-        for (int16_t yi = y0 + 1; yi < y0 + radius; ++yi) {
-            for (int16_t xi = x0 + radius; xi <= x1 - radius; ++xi) { // Python: range(x0 + radius, x1 - radius + 1)
-                 if (yi >= 0 && yi < bitmapHeight && xi >= 0 && xi < bitmapWidth) bitmap[yi * bitmapWidth + xi] = 1;
-            }
+        return;
+    }
+
+    // Corner arcs come from an integer midpoint quarter circle around the four corner centres.
+    const int16_t left = x0 + r;
+    const int16_t right = x1 - r;
+    const int16_t top = y0 + r;
+    const int16_t bottom = y1 - r;
+
+    if (fill) {
+        target.rect(left, y0, right, y1);
+    } else {
+        target.rect(left, y0, right, y0);
+        target.rect(left, y1, right, y1);
+        target.vspan(x0, top, bottom);
+        target.vspan(x1, top, bottom);
+    }
+
+    auto corners = [&](int16_t dx, int16_t dy) {
+        if (fill) {
+            target.vspan(left - dx, top - dy, bottom + dy);
+            target.vspan(right + dx, top - dy, bottom + dy);
+        } else {
+            target.plot(left - dx, top - dy);
+            target.plot(right + dx, top - dy);
+            target.plot(left - dx, bottom + dy);
+            target.plot(right + dx, bottom + dy);
         }
-        for (int16_t yi = y1 - radius + 1; yi < y1; ++yi) {
-            for (int16_t xi = x0 + radius; xi <= x1 - radius; ++xi) {
-                 if (yi >= 0 && yi < bitmapHeight && xi >= 0 && xi < bitmapWidth) bitmap[yi * bitmapWidth + xi] = 1;
-            }
+    };
+
+    int16_t ax = r;
+    int16_t ay = 0;
+    int16_t d = 1 - r;
+    while (ax >= ay) {
+        corners(ax, ay);
+        corners(ay, ax);
+        ay++;
+        if (d < 0) {
+            d += 2 * ay + 1;
+        } else {
+            ax--;
+            d += 2 * (ay - ax) + 1;
         }
     }
+}
 
-    // Horizontal edges
-    for (int16_t xi = x0 + radius; xi <= x1 - radius; ++xi) {
-        if (xi >= 0 && xi < bitmapWidth) {
-            if (y0 >= 0 && y0 < bitmapHeight) bitmap[y0 * bitmapWidth + xi] = 1;
-            if (y1 >= 0 && y1 < bitmapHeight) bitmap[y1 * bitmapWidth + xi] = 1;
-        }
+} // namespace
+
+void FutabaNAGP1250::drawGraphicLines(std::vector<uint8_t>& bitmap,
+                                      uint16_t width,
+                                      uint16_t height,
+                                      const std::vector<GraphicLine>& lines) {
+    if (bitmap.size() < static_cast<size_t>(width * height)) return;
+    for (const auto& line : lines) {
+        if (line.length == 0) continue;
+        int16_t x1, y1;
+        lineEndpoint(line, x1, y1);
+        drawGraphicLine(bitmap, line.x, line.y, x1, y1, width, height);
     }
+}
 
-    // Vertical edges
-    for (int16_t yi = y0 + radius; yi <= y1 - radius; ++yi) {
-        if (yi >= 0 && yi < bitmapHeight) {
-            if (x0 >= 0 && x0 < bitmapWidth) bitmap[yi * bitmapWidth + x0] = 1;
-            if (x1 >= 0 && x1 < bitmapWidth) bitmap[yi * bitmapWidth + x1] = 1;
-        }
+void FutabaNAGP1250::drawGraphicLines(FutabaNAGP1250Framebuffer& framebuffer,
+                                      const std::vector<GraphicLine>& lines) {
+    drawGraphicLines(framebuffer, lines.data(), lines.size());
+}
+
+void FutabaNAGP1250::drawGraphicLines(FutabaNAGP1250Framebuffer& framebuffer,
+                                      std::initializer_list<GraphicLine> lines) {
+    drawGraphicLines(framebuffer, lines.begin(), lines.size());
+}
+
+void FutabaNAGP1250::drawGraphicLines(FutabaNAGP1250Framebuffer& framebuffer,
+                                      const GraphicLine* lines, size_t count) {
+    if (!lines) return;
+    for (size_t n = 0; n < count; ++n) {
+        if (lines[n].length == 0) continue;
+        int16_t x1, y1;
+        lineEndpoint(lines[n], x1, y1);
+        drawGraphicLine(framebuffer, lines[n].x, lines[n].y, x1, y1);
     }
+}
 
-    // Corners
-    int16_t steps = radius * 2;
-    for (int16_t i = 0; i <= steps; ++i) {
-        float theta = (PI / 2.0f) * ((float)i / steps);
-        int16_t dx = static_cast<int16_t>(round(radius * cos(theta)));
-        int16_t dy = static_cast<int16_t>(round(radius * sin(theta)));
+void FutabaNAGP1250::drawGraphicLine(std::vector<uint8_t>& bitmap,
+                                     int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                                     uint16_t width, uint16_t height) {
+    if (bitmap.size() < static_cast<size_t>(width * height)) return;
+    rasterSegment(x0, y0, x1, y1, 0, width, height, [&](int16_t x, int16_t y) { bitmap[y * width + x] = 1; });
+}
 
-        // Top-left
-        int16_t px = x0 + radius - dx;
-        int16_t py = y0 + radius - dy;
-        if (px >= 0 && px < bitmapWidth && py >= 0 && py < bitmapHeight) bitmap[py * bitmapWidth + px] = 1;
-        if (fill) {
-            for (int16_t fy = py + 1; fy < y0 + radius; ++fy) {
-                if (fy >= 0 && fy < bitmapHeight) bitmap[fy * bitmapWidth + px] = 1;
-            }
-        }
+void FutabaNAGP1250::drawGraphicLine(FutabaNAGP1250Framebuffer& framebuffer,
+                                     int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+    if (y0 == y1) {
+        framebuffer.drawHorizontalLine(min(x0, x1), y0, abs(x1 - x0) + 1);
+    } else if (x0 == x1) {
+        framebuffer.drawVerticalLine(x0, min(y0, y1), abs(y1 - y0) + 1);
+    } else {
+        // rasterSegment clips, so pixels are written straight into the buffer's columns.
+        const int16_t origin = framebuffer.originX();
+        const uint8_t byteRows = framebuffer.byteRows();
+        uint8_t* const data = framebuffer.data();
+        rasterSegment(x0, y0, x1, y1, origin, framebuffer.width(), framebuffer.height(),
+                      [&](int16_t x, int16_t y) {
+                          uint8_t& cell = data[static_cast<size_t>(x - origin) * byteRows + (y >> 3)];
+                          const uint8_t bit = 0x80 >> (y & 7);
+                          if (!(cell & bit)) {
+                              cell |= bit;
+                              framebuffer.markColumnDirty(x - origin, y >> 3);
+                          }
+                      });
+    }
+}
 
-        // Top-right
-        px = x1 - radius + dx;
-        py = y0 + radius - dy;
-        if (px >= 0 && px < bitmapWidth && py >= 0 && py < bitmapHeight) bitmap[py * bitmapWidth + px] = 1;
-        if (fill) {
-            for (int16_t fy = py + 1; fy < y0 + radius; ++fy) {
-                if (fy >= 0 && fy < bitmapHeight) bitmap[fy * bitmapWidth + px] = 1;
-            }
-        }
+void FutabaNAGP1250::drawGraphicCircle(std::vector<uint8_t>& bitmap, 
+                                       uint16_t cx, uint16_t cy, uint16_t radius, 
+                                       uint16_t width, uint16_t height) {
+    if (bitmap.size() < static_cast<size_t>(width * height)) return;
+    rasterCircle(cx, cy, radius, 0, width, height, [&](int16_t x, int16_t y) { bitmap[y * width + x] = 1; });
+}
 
-        // Bottom-left
-        px = x0 + radius - dx;
-        py = y1 - radius + dy;
-        if (px >= 0 && px < bitmapWidth && py >= 0 && py < bitmapHeight) bitmap[py * bitmapWidth + px] = 1;
-        if (fill) {
-            for (int16_t fy = y1 - radius + 1; fy < py; ++fy) {
-                if (fy >= 0 && fy < bitmapHeight) bitmap[fy * bitmapWidth + px] = 1;
-            }
-        }
+void FutabaNAGP1250::drawGraphicCircle(FutabaNAGP1250Framebuffer& framebuffer,
+                                       uint16_t cx, uint16_t cy, uint16_t radius) {
+    rasterCircle(cx, cy, radius, framebuffer.originX(), framebuffer.width(), framebuffer.height(),
+                 [&](int16_t x, int16_t y) { framebuffer.setPixel(x, y); });
+}
 
-        // Bottom-right
-        px = x1 - radius + dx;
-        py = y1 - radius + dy;
-        if (px >= 0 && px < bitmapWidth && py >= 0 && py < bitmapHeight) bitmap[py * bitmapWidth + px] = 1;
-        if (fill) {
-            for (int16_t fy = y1 - radius + 1; fy < py; ++fy) {
-                if (fy >= 0 && fy < bitmapHeight) bitmap[fy * bitmapWidth + px] = 1;
+void FutabaNAGP1250::drawGraphicCircleFilled(std::vector<uint8_t>& bitmap, 
+                                             uint16_t cx, uint16_t cy, uint16_t radius, 
+                                             uint16_t width, uint16_t height) {
+    if (bitmap.size() < static_cast<size_t>(width * height)) return;
+    BitmapTarget target{bitmap, width};
+    rasterCircleFilled(cx, cy, radius, 0, width, height, target);
+}
+
+void FutabaNAGP1250::drawGraphicCircleFilled(FutabaNAGP1250Framebuffer& framebuffer,
+                                             uint16_t cx, uint16_t cy, uint16_t radius) {
+    FramebufferTarget target{framebuffer};
+    rasterCircleFilled(cx, cy, radius, framebuffer.originX(), framebuffer.width(), framebuffer.height(), target);
+}
+
+void FutabaNAGP1250::drawGraphicBox(std::vector<uint8_t>& bitmap, 
+                                    uint16_t x, uint16_t y, uint16_t w, uint16_t h, 
+                                    uint16_t bitmapWidth, uint16_t bitmapHeight,
+                                    uint16_t radius, bool fill) {
+    if (bitmap.size() < static_cast<size_t>(bitmapWidth * bitmapHeight)) return;
+    BitmapTarget target{bitmap, bitmapWidth};
+    rasterBox(x, y, w, h, bitmapWidth, bitmapHeight, radius, fill, target);
+}
+
+void FutabaNAGP1250::drawGraphicBox(FutabaNAGP1250Framebuffer& framebuffer,
+                                    uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+                                    uint16_t radius, bool fill) {
+    // The box shape is clamped to the whole screen, so a box drawn in strips keeps its corners;
+    // the target then clips it to the buffer's band.
+    const uint16_t screenWidth = framebuffer.screenWidth();
+    const int32_t x0 = min(static_cast<int32_t>(x), screenWidth - 1);
+    const int32_t x1 = min(static_cast<int32_t>(x) + w - 1, screenWidth - 1);
+    if (x1 < framebuffer.originX() || x0 >= framebuffer.originX() + framebuffer.width()) return;
+    FramebufferTarget target{framebuffer};
+    rasterBox(x, y, w, h, screenWidth, framebuffer.height(), radius, fill, target);
+}
+
+namespace {
+
+void blitSprite(FutabaNAGP1250Framebuffer& framebuffer, const uint8_t* sprite, bool flash,
+                uint16_t width, uint16_t height, int16_t x, int16_t y,
+                FutabaNAGP1250::WriteMode mode, bool mirror) {
+    x -= framebuffer.originX(); // buffer columns from here on
+    const int16_t x0 = max(x, static_cast<int16_t>(0));
+    const int16_t y0 = max(y, static_cast<int16_t>(0));
+    const int16_t x1 = min(static_cast<int32_t>(x) + width - 1, static_cast<int32_t>(framebuffer.width()) - 1);
+    const int16_t y1 = min(static_cast<int32_t>(y) + height - 1, static_cast<int32_t>(framebuffer.height()) - 1);
+    if (!sprite || width == 0 || height == 0 || x1 < x0 || y1 < y0) {
+        return;
+    }
+
+    // Source byte row k lands in framebuffer rows row0 + k (shifted down) and row0 + k + 1.
+    const uint16_t spriteRows = (height + 7) >> 3;
+    const int16_t row0 = y >= 0 ? y / 8 : -((7 - y) / 8);
+    const uint8_t shift = static_cast<uint8_t>(y - row0 * 8);
+
+    // The clipped sprite rectangle, one mask per covered framebuffer row as in fillRect.
+    const uint8_t firstRow = y0 >> 3;
+    const uint8_t lastRow = y1 >> 3;
+    uint8_t masks[FutabaNAGP1250Framebuffer::MAX_HEIGHT / 8];
+    for (uint8_t row = firstRow; row <= lastRow; ++row) {
+        const uint8_t top = row == firstRow ? (y0 & 7) : 0;
+        const uint8_t bottom = row == lastRow ? (y1 & 7) : 7;
+        masks[row] = static_cast<uint8_t>((0xFF >> top) & (0xFF << (7 - bottom)));
+    }
+
+    const uint8_t frameRows = framebuffer.byteRows();
+    uint8_t* column = framebuffer.data() + static_cast<size_t>(x0) * frameRows;
+    for (int16_t cx = x0; cx <= x1; ++cx, column += frameRows) {
+        const uint16_t sourceX = mirror ? (x + width - 1 - cx) : (cx - x);
+        const uint8_t* source = sprite + static_cast<size_t>(sourceX) * spriteRows;
+        int16_t k = firstRow - row0;
+        uint8_t previous = 0;
+        if (shift && k >= 1 && k - 1 < static_cast<int16_t>(spriteRows)) {
+            previous = flash ? pgm_read_byte(source + k - 1) : source[k - 1];
+        }
+        for (uint8_t row = firstRow; row <= lastRow; ++row, ++k) {
+            const uint8_t current = k < static_cast<int16_t>(spriteRows) ? (flash ? pgm_read_byte(source + k) : source[k]) : 0;
+            uint8_t bits = static_cast<uint8_t>(current >> shift);
+            if (shift) {
+                bits |= static_cast<uint8_t>(previous << (8 - shift));
+            }
+            previous = current;
+
+            const uint8_t mask = masks[row];
+            bits &= mask;
+            const uint8_t cell = column[row];
+            uint8_t updated;
+            switch (mode) {
+                case FutabaNAGP1250::WRITE_MODE_OR: updated = cell | bits; break;
+                case FutabaNAGP1250::WRITE_MODE_AND: updated = cell & (bits | ~mask); break;
+                case FutabaNAGP1250::WRITE_MODE_XOR: updated = cell ^ bits; break;
+                default: updated = (cell & ~mask) | bits; break;
+            }
+            if (updated != cell) {
+                column[row] = updated;
+                framebuffer.markColumnDirty(cx, row);
             }
         }
     }
 }
 
-void FutabaNAGP1250::sendBytes(const uint16_t* data, size_t length, bool waitBusy) {
+} // namespace
+
+void FutabaNAGP1250::drawSprite(FutabaNAGP1250Framebuffer& framebuffer, const uint8_t* sprite,
+                                uint16_t width, uint16_t height, int16_t x, int16_t y,
+                                WriteMode mode, bool mirror) {
+    blitSprite(framebuffer, sprite, false, width, height, x, y, mode, mirror);
+}
+
+void FutabaNAGP1250::drawSpriteP(FutabaNAGP1250Framebuffer& framebuffer, const uint8_t* sprite,
+                                 uint16_t width, uint16_t height, int16_t x, int16_t y,
+                                 WriteMode mode, bool mirror) {
+    blitSprite(framebuffer, sprite, true, width, height, x, y, mode, mirror);
+}
+
+void FutabaNAGP1250::drawSprite(FutabaNAGP1250Framebuffer& framebuffer, const FutabaNAGP1250Framebuffer& sprite,
+                                int16_t x, int16_t y, WriteMode mode, bool mirror) {
+    blitSprite(framebuffer, sprite.data(), false, sprite.width(), sprite.height(), x, y, mode, mirror);
+}
+
+void FutabaNAGP1250::sendBytes(const uint8_t* data, size_t length, bool waitBusy) {
+    sendBytes(data, length, waitBusy, classifyCommand(data, length));
+}
+
+void FutabaNAGP1250::sendBytes(const uint8_t* data, size_t length, bool waitBusy,
+                               FutabaNAGP1250Stats::Command command) {
     if (!data || !length) {
         return;
     }
+    countBytes(command, length);
+    // While batching, commands accumulate behind each other and go out in endBatch().
+    if (batchDepth_) {
+        appendBatch(data, 1, length, length);
+        return;
+    }
+    if (async_.active) {
+        finishAsync();
+    }
 
-    txBuffer_.clear();
-    txBuffer_.reserve(length * 2);
+    beginTransaction();
+    transport_->write(data, length);
+    transport_->endTransaction();
 
-    for (size_t i = 0; i < length; ++i) {
-        const uint16_t item = data[i];
-        if (item <= 0xFF) {
-            txBuffer_.push_back(item & 0xFF);
-        } else {
-            const uint8_t low = item & 0xFF;
-            const uint8_t high = (item >> 8) & 0xFF;
-            txBuffer_.push_back(low);
-            txBuffer_.push_back(high);
-        }
+    if (waitBusy) {
+        waitForBusy();
     }
+}
 
-    spi_.beginTransaction(spiSettings_);
-    for (uint8_t byte : txBuffer_) {
-        if (sbusyPin_ >= 0) {
-            while (digitalRead(sbusyPin_) == HIGH) {}
+void FutabaNAGP1250::writeRaw(const uint8_t* data, size_t length) {
+    invalidateState();
+    sendBytes(data, length);
+}
+
+void FutabaNAGP1250::beginBatch() {
+    if (batchDepth_++ == 0) {
+        if (async_.active) {
+            finishAsync();
         }
-        spi_.transfer(byte);
-        // VFDs can be slow to process bytes, especially in Read-Modify-Write modes (OR/AND/XOR).
-        // If SBUSY is NOT connected (-1), we must delay 400us to prevent overflow.
-        if (sbusyPin_ < 0) {
-             delayMicroseconds(400); 
+        txLength_ = 0;
+    }
+}
+
+void FutabaNAGP1250::endBatch() {
+    if (batchDepth_ == 0 || --batchDepth_ != 0) {
+        return;
+    }
+    if (txLength_ == 0) {
+        return;
+    }
+    flushTransmitBuffer();
+    waitForBusy();
+}
+
+void FutabaNAGP1250::setTransmitBuffer(uint8_t* buffer, size_t capacity) {
+    flushTransmitBuffer();
+    if (buffer && capacity) {
+        txBuffer_ = buffer;
+        txCapacity_ = capacity;
+    } else {
+        txBuffer_ = txStorage_.data();
+        txCapacity_ = txStorage_.size();
+    }
+}
+
+void FutabaNAGP1250::appendBatch(const uint8_t* data, size_t blocks, size_t blockLength, size_t stride) {
+    for (size_t block = 0; block < blocks; ++block) {
+        const uint8_t* src = data + block * stride;
+        size_t remaining = blockLength;
+        while (remaining) {
+            // A full buffer is sent early; the display just sees one continuous byte stream.
+            if (txLength_ == txCapacity_) {
+                flushTransmitBuffer();
+            }
+            const size_t take = min(remaining, txCapacity_ - txLength_);
+            memcpy(txBuffer_ + txLength_, src, take);
+            txLength_ += take;
+            src += take;
+            remaining -= take;
         }
     }
-    spi_.endTransaction();
+}
 
-    if (waitBusy) {
-        waitForBusy();
+void FutabaNAGP1250::flushTransmitBuffer() {
+    if (txLength_ == 0) {
+        return;
     }
+    beginTransaction();
+    transport_->write(txBuffer_, txLength_);
+    transport_->endTransaction();
+    txLength_ = 0;
 }
 
-void FutabaNAGP1250::sendBytes(std::initializer_list<uint16_t> list, bool waitBusy) {
+void FutabaNAGP1250::sendBytes(std::initializer_list<uint8_t> list, bool waitBusy) {
     sendBytes(list.begin(), list.size(), waitBusy);
 }
 
-void FutabaNAGP1250::waitForBusy(uint32_t timeoutUs) const {
-    if (sbusyPin_ < 0) {
+bool FutabaNAGP1250::statsEnabled() {
+    return FUTABA_NAGP1250_STATS != 0;
+}
+
+void FutabaNAGP1250::resetStats() {
+#if FUTABA_NAGP1250_STATS
+    stats_.reset();
+#endif
+    suppressedBytes_ = 0;
+}
+
+void FutabaNAGP1250::beginTransaction() {
+#if FUTABA_NAGP1250_STATS
+    ++stats_.transactions;
+#endif
+    transport_->beginTransaction();
+}
+
+void FutabaNAGP1250::countBytes(FutabaNAGP1250Stats::Command command, size_t count) {
+#if FUTABA_NAGP1250_STATS
+    stats_.bytes[command] += count;
+#else
+    (void)command;
+    (void)count;
+#endif
+}
+
+void FutabaNAGP1250::waitForBusy(uint32_t timeoutUs) {
+    if (transport_->waitIdle(timeoutUs)) {
         return;
     }
-
-    const uint32_t start = micros();
-    while (digitalRead(sbusyPin_)) {
-        if (micros() - start > timeoutUs) {
-            if (debug_) {
-                Serial.println(F("WARNING: SBUSY timeout"));
-            }
-            break;
-        }
-        delayMicroseconds(10);
+#if FUTABA_NAGP1250_STATS
+    ++stats_.timeouts;
+#endif
+    if (debug_) {
+        Serial.println(F("WARNING: SBUSY timeout"));
     }
 }
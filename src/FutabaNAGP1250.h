@@ -5,6 +5,17 @@
 #include <initializer_list>
 #include <vector>
 
+#include "FutabaNAGP1250CharacterCache.h"
+#include "FutabaNAGP1250Dither.h"
+#include "FutabaNAGP1250Font.h"
+#include "FutabaNAGP1250FrameCodec.h"
+#include "FutabaNAGP1250FrameScheduler.h"
+#include "FutabaNAGP1250Framebuffer.h"
+#include "FutabaNAGP1250Grayscale.h"
+#include "FutabaNAGP1250ScrollCanvas.h"
+#include "FutabaNAGP1250StripRenderer.h"
+#include "FutabaNAGP1250Transport.h"
+
 /**
  * Futaba NAGP1250 vacuum fluorescent display driver for Arduino compatible environments.
  *
@@ -61,6 +72,9 @@ public:
         CHAR_CODE_PC858 = 0x13,
     };
 
+    // Called once the last byte of an asynchronous transfer has been handed to the bus.
+    typedef void (*CompletionCallback)(void* context);
+
     struct GraphicLine {
         int16_t x;
         int16_t y;
@@ -74,13 +88,24 @@ public:
                    uint32_t spiFrequency = 115200,
                    bool debug = false);
 
+    // Drives the display through a caller-owned transport (see FutabaNAGP1250Transport.h),
+    // e.g. a bit-banged bus, a fixed flow-control strategy or the host emulator.
+    explicit FutabaNAGP1250(FutabaNAGP1250Transport& transport,
+                            int8_t resetPin = -1,
+                            bool debug = false);
+
+    ~FutabaNAGP1250();
+    FutabaNAGP1250(const FutabaNAGP1250&) = delete;
+    FutabaNAGP1250& operator=(const FutabaNAGP1250&) = delete;
+
     bool begin(uint8_t baseWindowMode = BASE_WINDOW_MODE_DEFAULT,
                uint8_t luminanceLevel = 4,
                int8_t cursorBlink = 0,
                uint8_t fontId = FONT_AMERICA,
                uint8_t characterCode = CHAR_CODE_PC437);
 
-    void resetDisplay() const;
+    // Pulses the reset pin (if wired) and forgets the shadow state.
+    void resetDisplay();
     void setLuminance(uint8_t level);
     void setCursorBlink(uint8_t mode);
     void setCursorPosition(uint16_t x, uint16_t y);
@@ -113,20 +138,156 @@ public:
     void setFontMagnification(uint8_t h, uint8_t v);
     void setCharacterSpacing(uint8_t mode);
 
+    // Download (user-defined) characters. A definition replaces the 5x7 font glyph of `code`
+    // with up to DOWNLOAD_CHARACTER_WIDTH column bytes (MSB on top); definitions only show
+    // while enabled with setDownloadCharacters(true), and the module forgets them when begin()
+    // initializes it. FutabaNAGP1250CharacterCache manages them for icons.
+    static constexpr uint8_t DOWNLOAD_CHARACTER_WIDTH = 5;
+    void setDownloadCharacters(bool enabled);
+    void defineDownloadCharacter(uint8_t code, const uint8_t* columns,
+                                 uint8_t width = DOWNLOAD_CHARACTER_WIDTH);
+    void deleteDownloadCharacter(uint8_t code);
+    // Incremented every time the module is initialized (ESC @) or reset through the reset pin;
+    // caches of state kept in the module compare it to notice that it was lost.
+    uint16_t initializeCount() const { return initializeCount_; }
+
 
     void displayGraphicImage(const std::vector<uint8_t>& image,
                              uint16_t width,
                              uint16_t height);
+    // Same for a packed image in caller-owned memory (`width * height / 8` bytes).
+    void displayGraphicImage(const uint8_t* image, uint16_t width, uint16_t height);
+
+    // Sends an already packed framebuffer as a single real-time bit image, no repacking.
+    void displayGraphicImage(const FutabaNAGP1250Framebuffer& framebuffer);
+
+    // Bit image sent in pieces, for producers that generate it on the fly (e.g. a frame decoder):
+    // begin sends the header, write appends `length` bytes of column data, end waits for the
+    // display. Exactly `width * byteRows` bytes must be written in between.
+    void beginGraphicImageStream(uint16_t width, uint8_t byteRows);
+    void writeGraphicImageStream(const uint8_t* data, size_t length);
+    void endGraphicImageStream();
+
+    // Uploads only the regions that changed since the previous flush, each as a cursor move plus
+    // a partial bit image, then clears the framebuffer's dirty state. The framebuffer is placed at
+    // its origin column (see FutabaNAGP1250Framebuffer::setOrigin) in the current window; like
+    // full uploads, the result is combined using the current write logic.
+    void flush(FutabaNAGP1250Framebuffer& framebuffer);
+
+    // Command batching. Between beginBatch() and endBatch() every command (text, cursor, write
+    // logic, windows, bit images, ...) is only encoded into the transmit buffer; endBatch() sends
+    // the whole buffer in one transaction followed by a single busy wait. If the buffer fills up
+    // first, its contents are sent early and encoding continues. Batches nest, and only the
+    // outermost endBatch() transmits. Prefer the scoped Batch guard:
+    //
+    //     {
+    //         FutabaNAGP1250::Batch batch(vfd);
+    //         vfd.setWriteLogic(FutabaNAGP1250::WRITE_MODE_XOR);
+    //         vfd.setCursorPosition(75, 1);
+    //         vfd.writeText("XOR");
+    //     } // sent here
+    void beginBatch();
+    void endBatch();
+    bool isBatching() const { return batchDepth_ != 0; }
+    size_t batchSize() const { return txLength_; }
+
+    // Replaces the built-in transmit buffer with caller-owned storage, e.g. a static array large
+    // enough to hold a whole batched frame. Pass nullptr to return to the built-in buffer. The
+    // built-in buffer is allocated once by the constructor (FUTABA_NAGP1250_TX_BUFFER_SIZE bytes,
+    // a library build flag); after that, commands are encoded on the stack or into this buffer.
+    void setTransmitBuffer(uint8_t* buffer, size_t capacity);
+
+    class Batch {
+    public:
+        explicit Batch(FutabaNAGP1250& display) : display_(display) { display_.beginBatch(); }
+        ~Batch() { display_.endBatch(); }
+        Batch(const Batch&) = delete;
+        Batch& operator=(const Batch&) = delete;
+
+    private:
+        FutabaNAGP1250& display_;
+    };
+
+    // Asynchronous transmit. The transfer is queued and streamed in the background by service(),
+    // which must be called regularly (e.g. from loop()); it never blocks on SBUSY or the
+    // no-SBUSY byte delay, it just returns and resumes on the next call. The data is not copied:
+    // the framebuffer or buffer must stay untouched until the transfer completes. Only one
+    // transfer can be in flight, none can start inside a batch, and blocking calls made
+    // meanwhile first drain it.
+    bool displayGraphicImageAsync(const FutabaNAGP1250Framebuffer& framebuffer,
+                                  CompletionCallback callback = nullptr,
+                                  void* context = nullptr);
+    bool sendAsync(const uint8_t* data, size_t length,
+                   CompletionCallback callback = nullptr,
+                   void* context = nullptr);
+    bool service(size_t maxBytes = 64);
+    bool isFrameInFlight() const { return async_.active; }
+    void finishAsync();
+
+    // With a transport built on FutabaNAGP1250SbusyIrqFlow, lets the SBUSY edge interrupt resume
+    // the queued transfer itself: every edge sends from interrupt context until SBUSY rises again,
+    // so the MCU can sleep or run other work while the display is busy and the loop does not
+    // have to call service(). Only enable it on cores where SPI may be used from an interrupt
+    // (AVR, Teensy, RP2040, ...); the completion callback then also runs in the interrupt.
+    void setServiceFromInterrupt(bool enabled);
+
+    // Upper bound for SBUSY-driven burst transfers. When SBUSY is wired, bytes are sent in chunks
+    // with one busy check per chunk; the chunk size adapts between 1 and this limit depending on
+    // how often the display asserts SBUSY. A limit of 1 restores per-byte polling.
+    void setBurstLimit(uint8_t maxBytes) { transport_->setBurstLimit(maxBytes); }
+    uint8_t burstSize() const { return transport_->burstSize(); }
+
+    FutabaNAGP1250Transport& transport() { return *transport_; }
+
+    // Sends already encoded command bytes (e.g. recorded through a FutabaNAGP1250CaptureTransport)
+    // unchanged, with the same batching and flow control as every other command. The driver
+    // cannot tell what they change, so the shadow state is invalidated.
+    void writeRaw(const uint8_t* data, size_t length);
+
+    // Shadow state. The driver remembers the settings it last sent (write logic, luminance,
+    // font, character code, selected window, magnification, character spacing, cursor blink,
+    // reverse mode and scroll speed) and drops commands that would not change them, so UI code
+    // can set them defensively every frame. Selecting the window that is already selected is
+    // dropped too and therefore does not move the cursor; use home() for that. begin(),
+    // resetDisplay(), writeRaw() and sendAsync() invalidate the shadow; call invalidateState()
+    // after changing the module by any other route. Disable shadowing for encoders whose output
+    // is interleaved with other streams (the display service does this for its producers).
+    void setStateShadowing(bool enabled);
+    bool stateShadowing() const { return shadowing_; }
+    void invalidateState();
+    // Bytes of redundant commands that were not sent (cleared by resetStats()).
+    uint32_t suppressedBytes() const { return suppressedBytes_; }
+
+    // Link statistics: bytes per command type, transactions, SBUSY stalls, fixed byte delays and
+    // timeouts. Only collected when the library is built with FUTABA_NAGP1250_STATS=1 (a build
+    // flag, see FutabaNAGP1250Stats.h); otherwise all zero and statsEnabled() is false.
+    const FutabaNAGP1250Stats& stats() const { return stats_; }
+    void resetStats();
+    static bool statsEnabled();
 
     static std::vector<uint8_t> packBitmap(const std::vector<uint8_t>& bitmap,
                                            uint16_t width,
                                            uint16_t height);
+    // Non-allocating variant: packs `width * height` bytes into `width * ((height + 7) / 8)`
+    // bytes at `out`.
+    static void packBitmap(const uint8_t* bitmap, uint16_t width, uint16_t height, uint8_t* out);
+    // Packs row-major 1bpp data (leftmost pixel in the MSB, rows `rowStride` bytes apart;
+    // 0 means `(width + 7) / 8`), e.g. a PBM P4 payload, into the same column-major layout.
+    static void packBitmap1bpp(const uint8_t* bits, uint16_t width, uint16_t height,
+                               uint8_t* out, size_t rowStride = 0);
 
+    // Each GraphicLine is `length` pixels from (x, y) at `angle_deg` (counter-clockwise, 0 points
+    // right). The end point comes from a fixed-point sine table interpolated to 1/4096 degree.
     static void drawGraphicLines(std::vector<uint8_t>& bitmap,
                                  uint16_t width,
                                  uint16_t height,
                                  const std::vector<GraphicLine>& lines);
 
+    // Straight line between two end points (both inclusive), integer Bresenham.
+    static void drawGraphicLine(std::vector<uint8_t>& bitmap,
+                                int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                                uint16_t width, uint16_t height);
+
     static void drawGraphicCircle(std::vector<uint8_t>& bitmap, 
                                   uint16_t cx, uint16_t cy, uint16_t radius, 
                                   uint16_t width, uint16_t height);
@@ -140,19 +301,117 @@ public:
                                uint16_t bitmapWidth, uint16_t bitmapHeight,
                                uint16_t radius = 0, bool fill = false);
 
+    // Packed framebuffer variants of the drawing helpers; the target size comes from the framebuffer.
+    static void drawGraphicLines(FutabaNAGP1250Framebuffer& framebuffer,
+                                 const std::vector<GraphicLine>& lines);
+    static void drawGraphicLines(FutabaNAGP1250Framebuffer& framebuffer,
+                                 std::initializer_list<GraphicLine> lines);
+    static void drawGraphicLines(FutabaNAGP1250Framebuffer& framebuffer,
+                                 const GraphicLine* lines, size_t count);
+
+    // Vertical lines are written as whole-byte runs and horizontal ones with a single mask.
+    static void drawGraphicLine(FutabaNAGP1250Framebuffer& framebuffer,
+                                int16_t x0, int16_t y0, int16_t x1, int16_t y1);
+
+    static void drawGraphicCircle(FutabaNAGP1250Framebuffer& framebuffer,
+                                  uint16_t cx, uint16_t cy, uint16_t radius);
+
+    static void drawGraphicCircleFilled(FutabaNAGP1250Framebuffer& framebuffer,
+                                        uint16_t cx, uint16_t cy, uint16_t radius);
+
+    static void drawGraphicBox(FutabaNAGP1250Framebuffer& framebuffer,
+                               uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+                               uint16_t radius = 0, bool fill = false);
+
+    // Software blitter. Copies a packed sprite (`width` columns of `(height + 7) / 8` bytes, MSB
+    // on top, the framebuffer and bit image layout) to (x, y) and combines it like the display's
+    // write logic: NORMAL replaces the sprite rectangle, OR/AND/XOR combine with what is there.
+    // The sprite is processed a byte column at a time, shifted across byte rows when y is not a
+    // multiple of 8, clipped to the framebuffer and, with `mirror`, flipped horizontally.
+    // drawSpriteP reads the sprite from PROGMEM.
+    static void drawSprite(FutabaNAGP1250Framebuffer& framebuffer, const uint8_t* sprite,
+                           uint16_t width, uint16_t height, int16_t x, int16_t y,
+                           WriteMode mode = WRITE_MODE_NORMAL, bool mirror = false);
+    static void drawSpriteP(FutabaNAGP1250Framebuffer& framebuffer, const uint8_t* sprite,
+                            uint16_t width, uint16_t height, int16_t x, int16_t y,
+                            WriteMode mode = WRITE_MODE_NORMAL, bool mirror = false);
+    static void drawSprite(FutabaNAGP1250Framebuffer& framebuffer, const FutabaNAGP1250Framebuffer& sprite,
+                           int16_t x, int16_t y, WriteMode mode = WRITE_MODE_NORMAL, bool mirror = false);
+
 private:
     void initialize();
-    void sendBytes(const uint16_t* data, size_t length, bool waitBusy = true);
-    void sendBytes(std::initializer_list<uint16_t> list, bool waitBusy = true);
-    void waitForBusy(uint32_t timeoutUs = 10000) const;
+    void sendBytes(const uint8_t* data, size_t length, bool waitBusy = true);
+    void sendBytes(std::initializer_list<uint8_t> list, bool waitBusy = true);
+    void sendBytes(const uint8_t* data, size_t length, bool waitBusy, FutabaNAGP1250Stats::Command command);
+    void beginTransaction();
+    void countBytes(FutabaNAGP1250Stats::Command command, size_t count);
+    void appendBatch(const uint8_t* data, size_t blocks, size_t blockLength, size_t stride);
+    void flushTransmitBuffer();
+    void waitForBusy(uint32_t timeoutUs = 10000);
+    void sendGraphicImage(const uint8_t* image, uint16_t width, uint16_t byteRows, uint16_t stride = 0);
+    static uint8_t encodeGraphicImageHeader(uint8_t* out, uint16_t width, uint16_t byteRows);
+
+    struct AsyncTransfer {
+        uint8_t header[9];
+        uint8_t headerLength;
+        uint8_t headerSent;
+        const uint8_t* payload;
+        size_t payloadLength;
+        size_t payloadSent;
+        CompletionCallback callback;
+        void* context;
+        volatile bool active;
+    };
+
+    void startAsync(const AsyncTransfer& transfer);
+    static void serviceFromInterrupt(void* context);
+
+    // Last value sent for each shadowed setting, UNKNOWN until the first command.
+    struct ShadowState {
+        static constexpr uint8_t UNKNOWN = 0xFF;
+        uint8_t writeLogic;
+        uint8_t luminance;
+        uint8_t font;
+        uint8_t characterCode;
+        uint8_t window;
+        uint8_t magnification; // h << 4 | v
+        uint8_t characterSpacing;
+        uint8_t cursorBlink;
+        uint8_t reverse;
+        uint8_t scrollSpeed;
+    };
+
+    // True if `field` already holds `value` (the command is then counted as suppressed);
+    // otherwise records `value` for the command about to be sent.
+    bool redundant(uint8_t& field, uint8_t value, uint8_t commandLength);
+
+    // Storage for the SPI transport built by the pin-based constructor. It is only constructed
+    // (and therefore only linked) when that constructor is used.
+    static constexpr size_t kDefaultTransportSize =
+        sizeof(FutabaNAGP1250SpiSbusyTransport) > sizeof(FutabaNAGP1250SpiTimedTransport)
+            ? sizeof(FutabaNAGP1250SpiSbusyTransport)
+            : sizeof(FutabaNAGP1250SpiTimedTransport);
+    alignas(FutabaNAGP1250SpiSbusyTransport) alignas(FutabaNAGP1250SpiTimedTransport)
+        uint8_t defaultTransport_[kDefaultTransportSize];
 
-    SPIClass& spi_;
-    SPISettings spiSettings_;
+    FutabaNAGP1250Transport* transport_;
     int8_t resetPin_;
-    int8_t sbusyPin_;
     bool debug_;
 
     uint16_t width_;
     uint16_t height_;
-    std::vector<uint8_t> txBuffer_;
+    std::vector<uint8_t> txStorage_;
+    uint8_t* txBuffer_;
+    size_t txCapacity_;
+    size_t txLength_;
+    uint8_t batchDepth_;
+    AsyncTransfer async_;
+    volatile bool servicing_;
+    volatile bool servicePending_;
+    bool interruptService_;
+    uint16_t initializeCount_;
+    ShadowState shadow_;
+    bool shadowing_;
+    uint32_t suppressedBytes_;
+    FutabaNAGP1250Stats stats_;
 };
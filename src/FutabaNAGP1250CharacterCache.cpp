@@ -0,0 +1,121 @@
+#include "FutabaNAGP1250CharacterCache.h"
+
+#include <string.h>
+
+#include "FutabaNAGP1250.h"
+
+// Download slots a character cache manages when the constructor is not given a count.
+#ifndef FUTABA_NAGP1250_CHARACTER_CACHE_SLOTS
+#ifdef __AVR__
+#define FUTABA_NAGP1250_CHARACTER_CACHE_SLOTS 8
+#else
+#define FUTABA_NAGP1250_CHARACTER_CACHE_SLOTS 32
+#endif
+#endif
+
+FutabaNAGP1250CharacterCache::FutabaNAGP1250CharacterCache(FutabaNAGP1250& display, uint8_t firstCode,
+                                                           uint8_t slots)
+    : display_(display),
+      firstCode_(max(firstCode, static_cast<uint8_t>(0x20))),
+      slots_(0),
+      clock_(0),
+      initializeCount_(display.initializeCount()),
+      enabled_(false),
+      hits_(0),
+      misses_(0),
+      evictions_(0) {
+    if (slots == 0) {
+        slots = FUTABA_NAGP1250_CHARACTER_CACHE_SLOTS;
+    }
+    // Slots may not run past code 0xFF.
+    const uint16_t available = 0x100 - firstCode_;
+    slots_ = static_cast<uint8_t>(min(static_cast<uint16_t>(slots), available));
+    slot_.resize(slots_);
+    invalidate();
+}
+
+void FutabaNAGP1250CharacterCache::invalidate() {
+    for (Slot& slot : slot_) {
+        slot.used = false;
+    }
+    enabled_ = false;
+    initializeCount_ = display_.initializeCount();
+}
+
+uint8_t FutabaNAGP1250CharacterCache::resident() const {
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < slots_; ++i) {
+        count += slot_[i].used;
+    }
+    return count;
+}
+
+uint8_t FutabaNAGP1250CharacterCache::codeP(const uint8_t* glyph) {
+    uint8_t copy[GLYPH_WIDTH];
+    for (uint8_t i = 0; i < GLYPH_WIDTH; ++i) {
+        copy[i] = pgm_read_byte(glyph + i);
+    }
+    return code(copy);
+}
+
+void FutabaNAGP1250CharacterCache::write(const uint8_t* glyph) {
+    // A download and the character that uses it go out in one transaction.
+    FutabaNAGP1250::Batch batch(display_);
+    const char text[2] = {static_cast<char>(code(glyph)), '\0'};
+    display_.writeText(text);
+}
+
+void FutabaNAGP1250CharacterCache::writeP(const uint8_t* glyph) {
+    FutabaNAGP1250::Batch batch(display_);
+    const char text[2] = {static_cast<char>(codeP(glyph)), '\0'};
+    display_.writeText(text);
+}
+
+uint8_t FutabaNAGP1250CharacterCache::code(const uint8_t* glyph) {
+    if (display_.initializeCount() != initializeCount_) {
+        invalidate(); // the module was initialized and dropped every download
+    }
+    ++clock_;
+
+    int16_t free = -1;
+    uint8_t victim = 0;
+    uint16_t oldest = 0;
+    for (uint8_t i = 0; i < slots_; ++i) {
+        Slot& slot = slot_[i];
+        if (!slot.used) {
+            if (free < 0) {
+                free = i;
+            }
+            continue;
+        }
+        if (memcmp(slot.glyph, glyph, GLYPH_WIDTH) == 0) {
+            slot.lastUse = clock_;
+            ++hits_;
+            return static_cast<uint8_t>(firstCode_ + i);
+        }
+        // Wrapping subtraction keeps ages right across clock overflow.
+        const uint16_t age = static_cast<uint16_t>(clock_ - slot.lastUse);
+        if (age >= oldest) {
+            oldest = age;
+            victim = i;
+        }
+    }
+
+    ++misses_;
+    if (free >= 0) {
+        victim = static_cast<uint8_t>(free);
+    } else {
+        ++evictions_;
+    }
+    if (!enabled_) {
+        display_.setDownloadCharacters(true);
+        enabled_ = true;
+    }
+    Slot& slot = slot_[victim];
+    memcpy(slot.glyph, glyph, GLYPH_WIDTH);
+    slot.used = true;
+    slot.lastUse = clock_;
+    const uint8_t character = static_cast<uint8_t>(firstCode_ + victim);
+    display_.defineDownloadCharacter(character, slot.glyph, GLYPH_WIDTH);
+    return character;
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <Arduino.h>
+#include <vector>
+
+class FutabaNAGP1250;
+
+/**
+ * Keeps small icons resident in the module as download characters.
+ *
+ * Icons (battery, signal, arrows, ...) are 5x7 glyphs in the download character format: one
+ * byte per column, MSB on top, like `FutabaNAGP1250Font::FONT_5X7`. The cache assigns each
+ * icon one of a range of character codes and downloads it on first use. After that, drawing the
+ * icon is a single byte of text at the cursor instead of a cursor move plus a bit image. When
+ * all codes are taken, the least recently used icon is replaced. Characters already on screen
+ * keep their pixels, because the module draws text into display RAM as it arrives.
+ *
+ *     FutabaNAGP1250CharacterCache icons(vfd);
+ *     vfd.setCursorPosition(130, 0);
+ *     icons.write(batteryIcon);
+ *
+ * The codes in use show icons instead of their font characters, so pick a range the sketch
+ * does not print (the default, 0xE0 and up, holds Greek letters and math symbols in PC437). The
+ * cache notices when the module is initialized by `begin()` or `resetDisplay()` and downloads
+ * everything again.
+ */
+class FutabaNAGP1250CharacterCache {
+public:
+    static constexpr uint8_t GLYPH_WIDTH = 5;
+
+    // Uses the codes `firstCode .. firstCode + slots - 1`. Each slot takes 8 bytes of RAM,
+    // allocated here; 0 picks FUTABA_NAGP1250_CHARACTER_CACHE_SLOTS (a library build flag, 8 on
+    // AVR and 32 elsewhere).
+    explicit FutabaNAGP1250CharacterCache(FutabaNAGP1250& display, uint8_t firstCode = 0xE0,
+                                          uint8_t slots = 0);
+
+    // Character code that shows `glyph` (GLYPH_WIDTH bytes), downloading it first if needed.
+    uint8_t code(const uint8_t* glyph);
+    // Same for a glyph stored in PROGMEM.
+    uint8_t codeP(const uint8_t* glyph);
+
+    // Writes the icon at the cursor, like one character of writeText().
+    void write(const uint8_t* glyph);
+    void writeP(const uint8_t* glyph);
+
+    // Forgets every download, e.g. after the module lost them without the driver's knowledge
+    // (a power cycle, or ESC @ sent through writeRaw()).
+    void invalidate();
+
+    uint8_t firstCode() const { return firstCode_; }
+    uint8_t slots() const { return slots_; }
+    uint8_t resident() const;
+    uint32_t hits() const { return hits_; }
+    uint32_t misses() const { return misses_; }
+    uint32_t evictions() const { return evictions_; }
+
+private:
+    struct Slot {
+        uint8_t glyph[GLYPH_WIDTH];
+        bool used;
+        uint16_t lastUse;
+    };
+
+    FutabaNAGP1250& display_;
+    uint8_t firstCode_;
+    uint8_t slots_;
+    std::vector<Slot> slot_;
+    uint16_t clock_;
+    uint16_t initializeCount_;
+    bool enabled_;
+    uint32_t hits_;
+    uint32_t misses_;
+    uint32_t evictions_;
+};
@@ -0,0 +1,181 @@
+#include "FutabaNAGP1250DisplayService.h"
+
+#if FUTABA_NAGP1250_HAS_ATOMIC
+
+FutabaNAGP1250DisplayService::FutabaNAGP1250DisplayService(FutabaNAGP1250& display, size_t capacity)
+    : display_(display), mask_(0), tail_(0), head_(0), rejected_(0) {
+    size_t size = 1;
+    while (size < capacity) {
+        size <<= 1;
+    }
+    slots_.reset(new Slot[size]);
+    mask_ = static_cast<uint32_t>(size - 1);
+    // A slot is free for position p while its sequence is p, and holds a published entry for
+    // position p once its sequence is p + 1.
+    for (uint32_t i = 0; i < size; ++i) {
+        slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+bool FutabaNAGP1250DisplayService::reserve(uint32_t slots, uint32_t& position) {
+    uint32_t tail = tail_.load(std::memory_order_relaxed);
+    for (;;) {
+        // The consumer frees slots in ring order, so if the last slot of the run is free for
+        // this lap, all the ones before it are too.
+        const uint32_t last = tail + slots - 1;
+        const int32_t diff = static_cast<int32_t>(slots_[last & mask_].sequence.load(std::memory_order_acquire) - last);
+        if (diff == 0) {
+            if (tail_.compare_exchange_weak(tail, tail + slots, std::memory_order_relaxed)) {
+                position = tail;
+                return true;
+            }
+        } else if (diff < 0) {
+            return false; // full
+        } else {
+            tail = tail_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool FutabaNAGP1250DisplayService::enqueue(const uint8_t* data, size_t length,
+                                           const uint8_t* image, uint16_t width, uint8_t byteRows,
+                                           CompletionCallback done, void* context) {
+    const size_t byteSlots = (length + SLOT_BYTES - 1) / SLOT_BYTES;
+    const size_t slots = byteSlots + (image ? 1 : 0);
+    uint32_t position;
+    if (!reserve(static_cast<uint32_t>(slots), position)) {
+        return false;
+    }
+
+    for (size_t i = 0; i < slots; ++i, ++position) {
+        Slot& slot = slots_[position & mask_];
+        if (i < byteSlots) {
+            const size_t offset = i * SLOT_BYTES;
+            slot.length = static_cast<uint8_t>(min(length - offset, static_cast<size_t>(SLOT_BYTES)));
+            memcpy(slot.bytes, data + offset, slot.length);
+            slot.kind = i + 1 < slots ? SLOT_BYTES_MORE : SLOT_BYTES_LAST;
+        } else {
+            slot.kind = SLOT_IMAGE;
+            slot.image = image;
+            slot.width = width;
+            slot.byteRows = byteRows;
+            slot.done = done;
+            slot.context = context;
+        }
+        slot.sequence.store(position + 1, std::memory_order_release);
+    }
+    return true;
+}
+
+size_t FutabaNAGP1250DisplayService::slotsFor(size_t length, const uint8_t* image) {
+    return (length + SLOT_BYTES - 1) / SLOT_BYTES + (image ? 1 : 0);
+}
+
+bool FutabaNAGP1250DisplayService::tryPost(const uint8_t* data, size_t length,
+                                           const uint8_t* image, uint16_t width, uint8_t byteRows,
+                                           CompletionCallback done, void* context) {
+    if (!data) {
+        length = 0;
+    }
+    const size_t slots = slotsFor(length, image);
+    if (slots == 0) {
+        return true;
+    }
+    if (slots > capacity() || !enqueue(data, length, image, width, byteRows, done, context)) {
+        rejected_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+bool FutabaNAGP1250DisplayService::post(const uint8_t* data, size_t length, uint32_t timeoutUs,
+                                        const uint8_t* image, uint16_t width, uint8_t byteRows,
+                                        CompletionCallback done, void* context) {
+    if (!data) {
+        length = 0;
+    }
+    const size_t slots = slotsFor(length, image);
+    if (slots == 0) {
+        return true;
+    }
+    const uint32_t start = micros();
+    if (slots <= capacity()) {
+        do {
+            if (enqueue(data, length, image, width, byteRows, done, context)) {
+                return true;
+            }
+            yield();
+        } while (micros() - start <= timeoutUs);
+    }
+    rejected_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+size_t FutabaNAGP1250DisplayService::process(size_t maxMessages) {
+    size_t messages = 0;
+    uint32_t head = head_.load(std::memory_order_relaxed);
+    if (slots_[head & mask_].sequence.load(std::memory_order_acquire) != head + 1) {
+        return 0;
+    }
+
+    // Everything drained in one call goes out as a single batch.
+    FutabaNAGP1250::Batch batch(display_);
+    while (messages < maxMessages) {
+        Slot& slot = slots_[head & mask_];
+        if (slot.sequence.load(std::memory_order_acquire) != head + 1) {
+            break; // empty, or the producer is still filling the rest of its message
+        }
+        if (slot.kind == SLOT_IMAGE) {
+            display_.displayGraphicImage(slot.image, slot.width, slot.byteRows * 8);
+            // In a batch the image has been copied or sent by now, so the producer may reuse it.
+            if (slot.done) {
+                slot.done(slot.context);
+            }
+            ++messages;
+        } else {
+            display_.writeRaw(slot.bytes, slot.length);
+            if (slot.kind == SLOT_BYTES_LAST) {
+                ++messages;
+            }
+        }
+        slot.sequence.store(head + mask_ + 1, std::memory_order_release);
+        head_.store(++head, std::memory_order_relaxed);
+    }
+    return messages;
+}
+
+FutabaNAGP1250DisplayService::Producer::Producer(FutabaNAGP1250DisplayService& service)
+    : service_(service), capture_(buffer_, sizeof(buffer_)), encoder_(capture_) {
+    // Other producers' messages land in between, so every setting has to be sent as asked.
+    encoder_.setStateShadowing(false);
+}
+
+bool FutabaNAGP1250DisplayService::Producer::tryPost() {
+    if (capture_.overflowed() || !service_.tryPost(capture_.data(), capture_.length())) {
+        return false;
+    }
+    capture_.clear();
+    return true;
+}
+
+bool FutabaNAGP1250DisplayService::Producer::post(uint32_t timeoutUs) {
+    if (capture_.overflowed() || !service_.post(capture_.data(), capture_.length(), timeoutUs)) {
+        return false;
+    }
+    capture_.clear();
+    return true;
+}
+
+bool FutabaNAGP1250DisplayService::Producer::postImage(const FutabaNAGP1250Framebuffer& frame,
+                                                       CompletionCallback done, void* context,
+                                                       uint32_t timeoutUs) {
+    if (capture_.overflowed() ||
+        !service_.post(capture_.data(), capture_.length(), timeoutUs,
+                       frame.data(), frame.width(), frame.byteRows(), done, context)) {
+        return false;
+    }
+    capture_.clear();
+    return true;
+}
+
+#endif
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <Arduino.h>
+
+// The display service needs <atomic>, which is missing on some cores (AVR). There the header
+// is empty and FUTABA_NAGP1250_HAS_ATOMIC is 0.
+#ifndef FUTABA_NAGP1250_HAS_ATOMIC
+#if defined(__has_include)
+#if __has_include(<atomic>)
+#define FUTABA_NAGP1250_HAS_ATOMIC 1
+#endif
+#endif
+#endif
+#ifndef FUTABA_NAGP1250_HAS_ATOMIC
+#define FUTABA_NAGP1250_HAS_ATOMIC 0
+#endif
+
+#if FUTABA_NAGP1250_HAS_ATOMIC
+
+#include <atomic>
+#include <memory>
+
+#include "FutabaNAGP1250.h"
+
+/**
+ * Shares one display between several tasks or threads.
+ *
+ * The service owns the display on a single consumer task, which calls process(). Any number of
+ * producers hand it encoded commands and bit images through a bounded lock-free ring, so
+ * producers never touch SPI or the driver's buffers and never block on each other. A message
+ * (the commands a producer posts at once, optionally followed by one image) may span several
+ * slots; all of them are claimed with a single atomic step, so messages from different
+ * producers are never interleaved. When the ring is full, tryPost() fails and post() waits, which
+ * pushes back on producers that outrun the display.
+ *
+ * Producers encode with the normal driver API through a `Producer`, typically one per task:
+ *
+ *     FutabaNAGP1250DisplayService::Producer alarms(service);
+ *     alarms.display().setCursorPosition(0, 3);
+ *     alarms.display().writeText("ALARM");
+ *     alarms.post();
+ */
+class FutabaNAGP1250DisplayService {
+public:
+    static constexpr uint8_t SLOT_BYTES = 32;
+    static constexpr size_t CAPTURE_SIZE = 256;
+
+    typedef FutabaNAGP1250::CompletionCallback CompletionCallback;
+
+    // `capacity` slots, rounded up to a power of two; allocated once here.
+    explicit FutabaNAGP1250DisplayService(FutabaNAGP1250& display, size_t capacity = 32);
+
+    // Non-blocking: false if the ring does not have room for the whole message right now.
+    // `image` (packed, `width * byteRows` bytes) is sent after `data`; it is not copied, so it
+    // must stay untouched until `done` runs on the consumer.
+    bool tryPost(const uint8_t* data, size_t length,
+                 const uint8_t* image = nullptr, uint16_t width = 0, uint8_t byteRows = 0,
+                 CompletionCallback done = nullptr, void* context = nullptr);
+    // Retries until there is room or `timeoutUs` has passed.
+    bool post(const uint8_t* data, size_t length, uint32_t timeoutUs = 0xFFFFFFFFUL,
+              const uint8_t* image = nullptr, uint16_t width = 0, uint8_t byteRows = 0,
+              CompletionCallback done = nullptr, void* context = nullptr);
+
+    // Consumer side, one task only: sends up to `maxMessages` queued messages in one batch and
+    // returns how many it sent.
+    size_t process(size_t maxMessages = SIZE_MAX);
+
+    size_t capacity() const { return mask_ + 1; }
+    // Slots currently taken (approximate while producers are active).
+    size_t pending() const {
+        return tail_.load(std::memory_order_relaxed) - head_.load(std::memory_order_relaxed);
+    }
+    // Messages refused by tryPost() and timed-out post() calls.
+    uint32_t rejected() const { return rejected_.load(std::memory_order_relaxed); }
+
+    /**
+     * Per-producer encoder: a private driver instance whose commands are recorded into a local
+     * buffer and handed to the service by post().
+     */
+    class Producer {
+    public:
+        explicit Producer(FutabaNAGP1250DisplayService& service);
+
+        // Encoder for the next message; only the command methods are meaningful (never begin()).
+        FutabaNAGP1250& display() { return encoder_; }
+
+        bool tryPost();
+        bool post(uint32_t timeoutUs = 0xFFFFFFFFUL);
+        // Commands recorded so far, then `frame` as a bit image at the current cursor.
+        bool postImage(const FutabaNAGP1250Framebuffer& frame, CompletionCallback done = nullptr,
+                       void* context = nullptr, uint32_t timeoutUs = 0xFFFFFFFFUL);
+
+        // Drops the recorded commands.
+        void clear() { capture_.clear(); }
+        // True if the recorded commands outgrew CAPTURE_SIZE (they are then not posted).
+        bool overflowed() const { return capture_.overflowed(); }
+
+    private:
+        FutabaNAGP1250DisplayService& service_;
+        uint8_t buffer_[CAPTURE_SIZE];
+        FutabaNAGP1250CaptureTransport capture_;
+        FutabaNAGP1250 encoder_;
+    };
+
+private:
+    enum SlotKind : uint8_t {
+        SLOT_BYTES_MORE,  // command bytes, message continues in the next slot
+        SLOT_BYTES_LAST,
+        SLOT_IMAGE,       // always last
+    };
+
+    struct Slot {
+        std::atomic<uint32_t> sequence;
+        SlotKind kind;
+        uint8_t length;
+        uint8_t bytes[SLOT_BYTES];
+        const uint8_t* image;
+        uint16_t width;
+        uint8_t byteRows;
+        CompletionCallback done;
+        void* context;
+    };
+
+    static size_t slotsFor(size_t length, const uint8_t* image);
+    bool reserve(uint32_t slots, uint32_t& position);
+    bool enqueue(const uint8_t* data, size_t length, const uint8_t* image, uint16_t width,
+                 uint8_t byteRows, CompletionCallback done, void* context);
+
+    FutabaNAGP1250& display_;
+    std::unique_ptr<Slot[]> slots_;
+    uint32_t mask_;
+    std::atomic<uint32_t> tail_;
+    std::atomic<uint32_t> head_;  // written by the consumer only
+    std::atomic<uint32_t> rejected_;
+};
+
+#endif
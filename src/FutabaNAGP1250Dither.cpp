@@ -0,0 +1,136 @@
+#include "FutabaNAGP1250Dither.h"
+
+namespace {
+
+// 8x8 Bayer matrix; a pixel is lit when its gray level exceeds 4 * entry + 2.
+const uint8_t kBayer8[8][8] PROGMEM = {
+    { 0, 32,  8, 40,  2, 34, 10, 42},
+    {48, 16, 56, 24, 50, 18, 58, 26},
+    {12, 44,  4, 36, 14, 46,  6, 38},
+    {60, 28, 52, 20, 62, 30, 54, 22},
+    { 3, 35, 11, 43,  1, 33,  9, 41},
+    {51, 19, 59, 27, 49, 17, 57, 25},
+    {15, 47,  7, 39, 13, 45,  5, 37},
+    {63, 31, 55, 23, 61, 29, 53, 21},
+};
+
+} // namespace
+
+FutabaNAGP1250Dither::FutabaNAGP1250Dither(uint16_t width, Mode mode)
+    : width_(constrain(width, static_cast<uint16_t>(1), FutabaNAGP1250Framebuffer::MAX_WIDTH)),
+      mode_(mode),
+      row_(0),
+      target_(nullptr),
+      callback_(nullptr),
+      context_(nullptr) {
+    startFrame();
+}
+
+void FutabaNAGP1250Dither::begin(FutabaNAGP1250Framebuffer& target) {
+    target_ = &target;
+    callback_ = nullptr;
+    context_ = nullptr;
+    width_ = target.width();
+    startFrame();
+}
+
+void FutabaNAGP1250Dither::begin(BandCallback callback, void* context) {
+    target_ = nullptr;
+    callback_ = callback;
+    context_ = context;
+    startFrame();
+}
+
+void FutabaNAGP1250Dither::startFrame() {
+    row_ = 0;
+    // Only allocates when the width grew since the last frame.
+    error_.assign(width_, 0);
+    band_.assign(width_, 0);
+}
+
+void FutabaNAGP1250Dither::writeRow(const uint8_t* gray, uint16_t sourceWidth) {
+    const uint16_t height = target_ ? target_->height() : FutabaNAGP1250Framebuffer::MAX_HEIGHT;
+    if (!gray || row_ >= height) {
+        return;
+    }
+    if (sourceWidth == 0) {
+        sourceWidth = width_;
+    }
+
+    // Output bits go straight into their column bytes: one byte per column in the band, or
+    // `byteRows` apart in the framebuffer.
+    uint8_t* out = target_ ? target_->data() + (row_ >> 3) : band_.data();
+    const size_t stride = target_ ? target_->byteRows() : 1;
+    const uint8_t mask = 0x80 >> (row_ & 7);
+    // 16.16 fixed-point source step for nearest-neighbour resampling.
+    const uint32_t step = (static_cast<uint32_t>(sourceWidth) << 16) / width_;
+    uint32_t position = 0;
+
+    auto put = [&](bool on) {
+        *out = on ? (*out | mask) : (*out & ~mask);
+        out += stride;
+    };
+
+    switch (mode_) {
+        case MODE_THRESHOLD:
+            for (uint16_t x = 0; x < width_; ++x, position += step) {
+                put(gray[position >> 16] >= 128);
+            }
+            break;
+
+        case MODE_BAYER: {
+            uint8_t thresholds[8];
+            for (uint8_t i = 0; i < 8; ++i) {
+                thresholds[i] = pgm_read_byte(&kBayer8[row_ & 7][i]) * 4 + 2;
+            }
+            for (uint16_t x = 0; x < width_; ++x, position += step) {
+                put(gray[position >> 16] > thresholds[x & 7]);
+            }
+            break;
+        }
+
+        case MODE_FLOYD_STEINBERG: {
+            // error_ holds the error pushed down from the previous row. It is replaced in place by
+            // the error for the next row, so the 1/16 share for the pixel below-right is carried
+            // in a local until that column has been read.
+            int16_t right = 0;
+            int16_t belowRight = 0;
+            for (uint16_t x = 0; x < width_; ++x, position += step) {
+                const int16_t value = gray[position >> 16] + error_[x] + right;
+                const bool on = value >= 128;
+                const int16_t error = value - (on ? 255 : 0);
+                put(on);
+
+                right = (error * 7) >> 4;
+                if (x > 0) {
+                    error_[x - 1] += (error * 3) >> 4;
+                }
+                error_[x] = ((error * 5) >> 4) + belowRight;
+                belowRight = error >> 4;
+            }
+            break;
+        }
+    }
+
+    if (target_) {
+        target_->markDirty(target_->originX(), row_, width_, 1); // buffer columns 0 .. width_ - 1
+    }
+    ++row_;
+    if ((row_ & 7) == 0) {
+        flushBand();
+    }
+}
+
+void FutabaNAGP1250Dither::end() {
+    if (row_ & 7) {
+        flushBand();
+    }
+}
+
+void FutabaNAGP1250Dither::flushBand() {
+    if (!callback_) {
+        return;
+    }
+    callback_(band_.data(), width_, (row_ - 1) >> 3, context_);
+    memset(band_.data(), 0, width_);
+}
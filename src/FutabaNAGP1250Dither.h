@@ -0,0 +1,67 @@
+#pragma once
+
+#include <Arduino.h>
+#include <vector>
+
+#include "FutabaNAGP1250Framebuffer.h"
+
+/**
+ * Streaming grayscale to 1bpp converter.
+ *
+ * 8-bit grayscale rows are fed one at a time with `writeRow` and dithered straight into the
+ * display's packed column format: each output bit is ORed into its column byte as soon as it is
+ * decided, so neither a grayscale frame nor a separate packing pass is needed. The packed result
+ * goes either into a `FutabaNAGP1250Framebuffer` or, for sources that should not hold a frame at
+ * all, into an internal one-byte-row band that is handed to a callback every 8 rows (ready to be
+ * uploaded as an 8 pixel high bit image).
+ *
+ * Error diffusion keeps one row of pending error (2 bytes per column); ordered dithering is
+ * stateless. The error row and the band (1 byte per column) are allocated for the output width
+ * when the dither is constructed, so construct it with the width it will be used at: 420 bytes
+ * for 140 columns. Starting a frame wider than that reallocates them.
+ */
+class FutabaNAGP1250Dither {
+public:
+    enum Mode : uint8_t {
+        MODE_THRESHOLD = 0,       // plain 50% threshold
+        MODE_BAYER = 1,           // 8x8 ordered dither
+        MODE_FLOYD_STEINBERG = 2, // error diffusion
+    };
+
+    // Receives `width` packed column bytes for byte row `byteRow` (pixel rows 8 * byteRow..+7).
+    typedef void (*BandCallback)(const uint8_t* band, uint16_t width, uint8_t byteRow, void* context);
+
+    explicit FutabaNAGP1250Dither(uint16_t width = 140, Mode mode = MODE_BAYER);
+
+    // Starts a frame. Rows are written into `target` (its width wins) and marked dirty.
+    void begin(FutabaNAGP1250Framebuffer& target);
+    // Starts a frame whose rows are delivered to `callback` in 8-row bands.
+    void begin(BandCallback callback, void* context = nullptr);
+
+    // Dithers the next row. `gray` holds `sourceWidth` pixels (0 means the output width); other
+    // widths are resampled nearest-neighbour, so sources can send downscaled data.
+    void writeRow(const uint8_t* gray, uint16_t sourceWidth = 0);
+    // Hands over a partially filled last band. Only needed in band mode when the number of rows
+    // is not a multiple of 8.
+    void end();
+
+    void setMode(Mode mode) { mode_ = mode; }
+    Mode mode() const { return mode_; }
+    uint16_t width() const { return width_; }
+    uint16_t row() const { return row_; }
+
+private:
+    void startFrame();
+    void flushBand();
+
+    uint16_t width_;
+    Mode mode_;
+    uint16_t row_;
+
+    FutabaNAGP1250Framebuffer* target_;
+    BandCallback callback_;
+    void* context_;
+
+    std::vector<int16_t> error_;
+    std::vector<uint8_t> band_;
+};
@@ -0,0 +1,414 @@
+#include "FutabaNAGP1250Emulator.h"
+
+#include <string.h>
+
+FutabaNAGP1250Emulator::FutabaNAGP1250Emulator() : FutabaNAGP1250Emulator(Timing()) {}
+
+FutabaNAGP1250Emulator::FutabaNAGP1250Emulator(const Timing& timing) : timing_(timing) {
+    reset();
+}
+
+void FutabaNAGP1250Emulator::reset() {
+    initializeState();
+    commandLength_ = 0;
+
+    pendingHead_ = 0;
+    pendingCount_ = 0;
+    lastCompletionUs_ = 0;
+
+    bytesReceived_ = 0;
+    commandsExecuted_ = 0;
+    charactersWritten_ = 0;
+    imageBytesWritten_ = 0;
+    downloadsDefined_ = 0;
+    overruns_ = 0;
+}
+
+void FutabaNAGP1250Emulator::initializeState() {
+    memset(ram_, 0, sizeof(ram_));
+    imageRemaining_ = 0;
+    downloadActive_ = false;
+    downloadEnabled_ = false;
+    memset(downloadDefined_, 0, sizeof(downloadDefined_));
+
+    baseWidth_ = 140;
+    memset(windows_, 0, sizeof(windows_));
+    windows_[0] = {0, 0, baseWidth_, RAM_BYTE_ROWS, true};
+    window_ = 0;
+    cursorX_ = 0;
+    cursorY_ = 0;
+    writeLogic_ = 0;
+    luminance_ = 8;
+    font_ = 0;
+    characterCode_ = 0;
+    magnificationH_ = 1;
+    magnificationV_ = 1;
+    scrollBytes_ = 0;
+}
+
+void FutabaNAGP1250Emulator::write(const uint8_t* data, size_t length, uint32_t nowUs) {
+    for (size_t i = 0; i < length; ++i) {
+        write(data[i], nowUs);
+    }
+}
+
+void FutabaNAGP1250Emulator::write(uint8_t byte, uint32_t nowUs) {
+    retireCompleted(nowUs);
+    if (pendingCount_ >= timing_.inputBufferSize) {
+        ++overruns_;
+    }
+    ++bytesReceived_;
+
+    uint32_t cost = timing_.commandByteUs;
+    if (imageRemaining_) {
+        cost = writeImageByte(byte);
+    } else if (downloadActive_) {
+        cost = writeDownloadByte(byte);
+    } else {
+        command_[commandLength_++] = byte;
+        const int16_t length = commandLength();
+        if (length >= 0 && commandLength_ >= length) {
+            cost = execute();
+            commandLength_ = 0;
+        } else if (commandLength_ >= sizeof(command_)) {
+            commandLength_ = 0; // Malformed; resynchronise on the next byte.
+        }
+    }
+
+    const uint32_t start = (static_cast<int32_t>(lastCompletionUs_ - nowUs) > 0) ? lastCompletionUs_ : nowUs;
+    lastCompletionUs_ = start + cost;
+    if (pendingCount_ < MAX_INPUT_BUFFER) {
+        pending_[(pendingHead_ + pendingCount_) % MAX_INPUT_BUFFER] = lastCompletionUs_;
+        ++pendingCount_;
+    } else {
+        // Keep the newest completion time so the ring still drains at the right moment.
+        pending_[(pendingHead_ + pendingCount_ - 1) % MAX_INPUT_BUFFER] = lastCompletionUs_;
+    }
+}
+
+bool FutabaNAGP1250Emulator::busy(uint32_t nowUs) {
+    retireCompleted(nowUs);
+    return pendingCount_ >= timing_.inputBufferSize;
+}
+
+uint32_t FutabaNAGP1250Emulator::readyAtUs() const {
+    if (pendingCount_ < timing_.inputBufferSize) {
+        return pendingCount_ ? pending_[pendingHead_] : lastCompletionUs_;
+    }
+    // SBUSY drops once enough queued bytes have been consumed to make room for one more.
+    const uint8_t excess = pendingCount_ - timing_.inputBufferSize;
+    return pending_[(pendingHead_ + excess) % MAX_INPUT_BUFFER];
+}
+
+void FutabaNAGP1250Emulator::retireCompleted(uint32_t nowUs) {
+    while (pendingCount_ && static_cast<int32_t>(pending_[pendingHead_] - nowUs) <= 0) {
+        pendingHead_ = (pendingHead_ + 1) % MAX_INPUT_BUFFER;
+        --pendingCount_;
+    }
+}
+
+bool FutabaNAGP1250Emulator::pixel(uint16_t x, uint16_t y) const {
+    if (x >= RAM_WIDTH || y >= RAM_BYTE_ROWS * 8) {
+        return false;
+    }
+    return ram_[ramIndex(x, y >> 3)] & (0x80 >> (y & 7));
+}
+
+uint16_t FutabaNAGP1250Emulator::ramIndex(uint16_t x, uint8_t row) const {
+    // Display scrolling moves the start address of the linear, column-major display RAM.
+    return (static_cast<uint32_t>(x) * RAM_BYTE_ROWS + row + scrollBytes_) % RAM_SIZE;
+}
+
+void FutabaNAGP1250Emulator::writeRamByte(uint16_t x, uint8_t row, uint8_t value) {
+    uint8_t& cell = ram_[ramIndex(x, row)];
+    switch (writeLogic_) {
+        case 1: cell |= value; break;
+        case 2: cell &= value; break;
+        case 3: cell ^= value; break;
+        default: cell = value; break;
+    }
+}
+
+int16_t FutabaNAGP1250Emulator::commandLength() const {
+    const uint8_t* c = command_;
+    if (c[0] != 0x1B && c[0] != 0x1F) {
+        return 1; // Control code or character.
+    }
+    if (commandLength_ < 2) {
+        return -1;
+    }
+
+    if (c[0] == 0x1B) {
+        switch (c[1]) {
+            case 0x40: return 2;                // ESC @ initialize
+            case 0x52:                          // ESC R font
+            case 0x74:                          // ESC t character code
+            case 0x25: return 3;                // ESC % download character enable
+            case 0x26: return 5;                // ESC & a c1 c2, glyph data streamed after
+            case 0x3F: return 4;                // ESC ? delete download character
+            default: return 2;
+        }
+    }
+
+    switch (c[1]) {
+        case 0x01:
+        case 0x02:
+        case 0x03: return 2;                    // MD1..MD3
+        case 0x43:                              // cursor on/off
+        case 0x58:                              // luminance
+        case 0x72:                              // reverse
+        case 0x73:                              // horizontal scroll speed
+        case 0x77: return 3;                    // write logic
+        case 0x24: return 6;                    // cursor position
+        case 0x28: break;
+        default: return 2;
+    }
+
+    if (commandLength_ < 4) {
+        return -1;
+    }
+    const uint16_t function = (c[2] << 8) | c[3];
+    switch (function) {
+        case 0x7701:                            // select window
+        case 0x7710: return 5;                  // base window mode
+        case 0x7702:                            // define / delete user window
+            if (commandLength_ < 6) return -1;
+            return c[5] ? 14 : 6;
+        case 0x6101:                            // wait
+        case 0x6140: return 5;                  // screen saver
+        case 0x6110: return 9;                  // display scroll
+        case 0x6111: return 8;                  // blink
+        case 0x6611: return 9;                  // real-time bit image header
+        case 0x6740: return 6;                  // font magnification
+        case 0x6703: return 5;                  // character spacing
+        default: return 4;
+    }
+}
+
+uint32_t FutabaNAGP1250Emulator::execute() {
+    const uint8_t* c = command_;
+    ++commandsExecuted_;
+
+    if (c[0] >= 0x20) {
+        return writeCharacter();
+    }
+
+    Window& win = windows_[window_];
+    const uint8_t cellWidth = 6 * magnificationH_;
+    switch (c[0]) {
+        case 0x08:
+            cursorX_ = (cursorX_ >= cellWidth) ? cursorX_ - cellWidth : 0;
+            return timing_.commandByteUs;
+        case 0x09:
+            cursorX_ += cellWidth;
+            if (cursorX_ + cellWidth > win.w) advanceLine();
+            return timing_.commandByteUs;
+        case 0x0A:
+            cursorY_ += magnificationV_;
+            if (cursorY_ + magnificationV_ > win.h) cursorY_ = 0;
+            return timing_.commandByteUs;
+        case 0x0B:
+            cursorX_ = 0;
+            cursorY_ = 0;
+            return timing_.commandByteUs;
+        case 0x0C:
+            clearWindow(window_);
+            return timing_.clearUs;
+        case 0x0D:
+            cursorX_ = 0;
+            return timing_.commandByteUs;
+        case 0x1B:
+            switch (c[1]) {
+                case 0x40:
+                    initializeState();
+                    return timing_.initializeUs;
+                case 0x52: font_ = c[2]; break;
+                case 0x74: characterCode_ = c[2]; break;
+                case 0x25: downloadEnabled_ = c[2] & 0x01; break;
+                case 0x26:
+                    if ((c[2] == 1 || c[2] == 2) && c[3] >= 0x20 && c[3] <= c[4]) {
+                        downloadActive_ = true;
+                        downloadCode_ = c[3];
+                        downloadLast_ = c[4];
+                        downloadHeight_ = c[2];
+                        downloadWidth_ = 0;
+                    }
+                    break;
+                case 0x3F:
+                    if (c[2] == 1) {
+                        downloadDefined_[c[3] >> 3] &= ~(1 << (c[3] & 7));
+                    }
+                    break;
+                default: break;
+            }
+            return timing_.commandByteUs;
+        default:
+            break;
+    }
+
+    if (c[0] != 0x1F) {
+        return timing_.commandByteUs;
+    }
+
+    switch (c[1]) {
+        case 0x24: {
+            const uint16_t x = c[2] | (c[3] << 8);
+            const uint16_t y = c[4] | (c[5] << 8);
+            if (x < win.w && y < win.h) {
+                cursorX_ = x;
+                cursorY_ = y;
+            }
+            return timing_.commandByteUs;
+        }
+        case 0x58: luminance_ = c[2]; return timing_.commandByteUs;
+        case 0x77: writeLogic_ = c[2] & 0x03; return timing_.commandByteUs;
+        case 0x28: break;
+        default: return timing_.commandByteUs;
+    }
+
+    const uint16_t function = (c[2] << 8) | c[3];
+    switch (function) {
+        case 0x7701:
+            if (c[4] <= 4 && windows_[c[4]].defined) {
+                window_ = c[4];
+                cursorX_ = 0;
+                cursorY_ = 0;
+            }
+            break;
+        case 0x7710:
+            baseWidth_ = c[4] ? RAM_WIDTH : 140;
+            windows_[0].w = baseWidth_;
+            break;
+        case 0x7702: {
+            const uint8_t n = c[4];
+            if (n < 1 || n > 4) break;
+            if (c[5]) {
+                windows_[n] = {static_cast<uint16_t>(c[6] | (c[7] << 8)), c[8],
+                               static_cast<uint16_t>(c[10] | (c[11] << 8)), c[12], true};
+            } else {
+                windows_[n].defined = false;
+                if (window_ == n) window_ = 0;
+            }
+            break;
+        }
+        case 0x6110: {
+            const uint16_t shift = c[4] | (c[5] << 8);
+            const uint16_t repeat = c[6] | (c[7] << 8);
+            scrollBytes_ = (scrollBytes_ + static_cast<uint32_t>(shift) * repeat) % RAM_SIZE;
+            return static_cast<uint32_t>(timing_.scrollStepUs) * repeat * (c[8] + 1);
+        }
+        case 0x6611: {
+            imageWidth_ = c[4] | (c[5] << 8);
+            imageByteRows_ = c[6] | (c[7] << 8);
+            imageRemaining_ = static_cast<uint32_t>(imageWidth_) * imageByteRows_;
+            imageX_ = cursorX_;
+            imageY_ = cursorY_;
+            imageColumn_ = 0;
+            imageRow_ = 0;
+            break;
+        }
+        case 0x6740:
+            magnificationH_ = c[4];
+            magnificationV_ = c[5];
+            break;
+        default:
+            break;
+    }
+    return timing_.commandByteUs;
+}
+
+uint32_t FutabaNAGP1250Emulator::writeImageByte(uint8_t byte) {
+    const Window& win = windows_[window_];
+    const uint16_t x = imageX_ + imageColumn_;
+    const uint8_t row = imageY_ + imageRow_;
+    // The bit image is clipped to the current window; the cursor does not move.
+    if (x < win.w && row < win.h) {
+        writeRamByte(win.x + x, win.y + row, byte);
+    }
+    ++imageBytesWritten_;
+
+    if (++imageRow_ == imageByteRows_) {
+        imageRow_ = 0;
+        ++imageColumn_;
+    }
+    --imageRemaining_;
+    return writeLogic_ ? timing_.logicImageByteUs : timing_.imageByteUs;
+}
+
+uint32_t FutabaNAGP1250Emulator::writeDownloadByte(uint8_t byte) {
+    // Each character is its column count x followed by x * a data bytes.
+    if (downloadWidth_ == 0) {
+        if (byte == 0 || byte > DOWNLOAD_WIDTH * downloadHeight_) {
+            downloadActive_ = false; // malformed
+            return timing_.commandByteUs;
+        }
+        downloadWidth_ = byte;
+        downloadReceived_ = 0;
+        if (downloadHeight_ == 1) {
+            memset(downloadGlyphs_[downloadCode_], 0, DOWNLOAD_WIDTH);
+        }
+        return timing_.commandByteUs;
+    }
+
+    // Only 5x7 characters are kept; 10x14 ones are parsed and dropped.
+    if (downloadHeight_ == 1) {
+        downloadGlyphs_[downloadCode_][downloadReceived_] = byte;
+    }
+    if (++downloadReceived_ == downloadWidth_ * downloadHeight_) {
+        if (downloadHeight_ == 1) {
+            downloadDefined_[downloadCode_ >> 3] |= 1 << (downloadCode_ & 7);
+            ++downloadsDefined_;
+        }
+        downloadWidth_ = 0;
+        if (++downloadCode_ > downloadLast_) {
+            downloadActive_ = false;
+        }
+    }
+    return timing_.commandByteUs;
+}
+
+const uint8_t* FutabaNAGP1250Emulator::downloadCharacter(uint8_t code) const {
+    return (downloadDefined_[code >> 3] & (1 << (code & 7))) ? downloadGlyphs_[code] : nullptr;
+}
+
+uint32_t FutabaNAGP1250Emulator::writeCharacter() {
+    const Window& win = windows_[window_];
+    const uint8_t cellWidth = 6 * magnificationH_;
+    if (cursorX_ + cellWidth > win.w) {
+        advanceLine();
+    }
+    const uint8_t* glyph = downloadEnabled_ ? downloadCharacter(command_[0]) : nullptr;
+    if (glyph && magnificationH_ == 1 && magnificationV_ == 1) {
+        for (uint8_t dx = 0; dx < cellWidth; ++dx) {
+            writeRamByte(win.x + cursorX_ + dx, win.y + cursorY_, dx < DOWNLOAD_WIDTH ? glyph[dx] : 0);
+        }
+    } else if (writeLogic_ == 0) {
+        for (uint8_t dx = 0; dx < cellWidth; ++dx) {
+            for (uint8_t dy = 0; dy < magnificationV_ && cursorY_ + dy < win.h; ++dy) {
+                writeRamByte(win.x + cursorX_ + dx, win.y + cursorY_ + dy, 0);
+            }
+        }
+    }
+    cursorX_ += cellWidth;
+    ++charactersWritten_;
+    return static_cast<uint32_t>(timing_.characterUs) * magnificationH_ * magnificationV_;
+}
+
+void FutabaNAGP1250Emulator::advanceLine() {
+    cursorX_ = 0;
+    cursorY_ += magnificationV_;
+    if (cursorY_ + magnificationV_ > windows_[window_].h) {
+        cursorY_ = 0;
+    }
+}
+
+void FutabaNAGP1250Emulator::clearWindow(uint8_t window) {
+    const Window& win = windows_[window];
+    for (uint16_t x = 0; x < win.w; ++x) {
+        for (uint8_t row = 0; row < win.h; ++row) {
+            ram_[ramIndex(win.x + x, win.y + row)] = 0;
+        }
+    }
+    cursorX_ = 0;
+    cursorY_ = 0;
+}
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Software model of a NAGP1250 module for host builds, tests and profiling.
+ *
+ * The emulator consumes the exact byte stream the driver puts on the wire, parses the ESC/US
+ * command set (initialize, cursor, write logic, windows, clear, scrolling, real-time bit images
+ * and text) and applies it to a 256x32 display RAM stored in the same column-major, MSB-top
+ * layout as `FutabaNAGP1250Framebuffer`. It has no Arduino dependencies.
+ *
+ * Timing is modelled on a caller-supplied microsecond clock: every byte is given a processing
+ * cost and queued in a bounded input buffer, and SBUSY reads high while that buffer is full.
+ * Bytes received while busy are still processed but counted as overruns, so flow-control bugs
+ * show up in `overruns()` rather than as silent corruption.
+ *
+ * The character generator ROM is not modelled: text advances the cursor and, in normal write
+ * logic, blanks the character cell. Download characters (ESC &) are stored and, while enabled
+ * with ESC %, drawn with their real glyphs at 1x magnification.
+ */
+class FutabaNAGP1250Emulator {
+public:
+    static constexpr uint16_t RAM_WIDTH = 256;
+    static constexpr uint8_t RAM_BYTE_ROWS = 4;
+    static constexpr uint16_t RAM_SIZE = RAM_WIDTH * RAM_BYTE_ROWS;
+    static constexpr uint8_t MAX_INPUT_BUFFER = 64;
+    static constexpr uint8_t DOWNLOAD_WIDTH = 5;
+
+    // Approximate per-operation processing costs in microseconds. The defaults are conservative
+    // estimates; tune them against a real module when benchmarking.
+    struct Timing {
+        uint16_t commandByteUs = 10;
+        uint16_t imageByteUs = 8;
+        uint16_t logicImageByteUs = 16;   // OR/AND/XOR read-modify-write
+        uint16_t characterUs = 120;
+        uint16_t clearUs = 1000;
+        uint16_t initializeUs = 2000;
+        uint16_t scrollStepUs = 500;
+        uint8_t inputBufferSize = 32;     // bytes queued before SBUSY goes high
+    };
+
+    FutabaNAGP1250Emulator();
+    explicit FutabaNAGP1250Emulator(const Timing& timing);
+
+    // Power-on state: RAM, parser, input buffer and counters cleared. ESC @ on the wire only
+    // resets the display state, like the real module.
+    void reset();
+
+    void write(uint8_t byte, uint32_t nowUs = 0);
+    void write(const uint8_t* data, size_t length, uint32_t nowUs = 0);
+
+    // SBUSY level at `nowUs`. While busy, readyAtUs() is the time SBUSY drops again;
+    // idleAtUs() is when all queued work is done.
+    bool busy(uint32_t nowUs);
+    uint32_t readyAtUs() const;
+    uint32_t idleAtUs() const { return lastCompletionUs_; }
+
+    // Visible pixel at screen coordinates (takes display scrolling into account).
+    bool pixel(uint16_t x, uint16_t y) const;
+    // Raw display RAM, column-major with `RAM_BYTE_ROWS` bytes per column.
+    const uint8_t* ram() const { return ram_; }
+
+    uint16_t visibleWidth() const { return baseWidth_; }
+    uint16_t cursorX() const { return cursorX_; }
+    uint8_t cursorY() const { return cursorY_; }
+    uint8_t writeLogic() const { return writeLogic_; }
+    uint8_t luminance() const { return luminance_; }
+    uint8_t currentWindow() const { return window_; }
+    uint8_t font() const { return font_; }
+    uint8_t characterCode() const { return characterCode_; }
+    uint16_t scrollOffsetBytes() const { return scrollBytes_; }
+    bool downloadCharactersEnabled() const { return downloadEnabled_; }
+    // Columns of the 5x7 download character `code`, or nullptr if it is not defined.
+    const uint8_t* downloadCharacter(uint8_t code) const;
+
+    uint32_t bytesReceived() const { return bytesReceived_; }
+    uint32_t commandsExecuted() const { return commandsExecuted_; }
+    uint32_t charactersWritten() const { return charactersWritten_; }
+    uint32_t imageBytesWritten() const { return imageBytesWritten_; }
+    uint32_t downloadsDefined() const { return downloadsDefined_; }
+    uint32_t overruns() const { return overruns_; }
+
+    const Timing& timing() const { return timing_; }
+    void setTiming(const Timing& timing) { timing_ = timing; }
+
+private:
+    struct Window {
+        uint16_t x;
+        uint8_t y;
+        uint16_t w;
+        uint8_t h;
+        bool defined;
+    };
+
+    void initializeState();
+    int16_t commandLength() const;
+    uint32_t execute();
+    uint32_t writeImageByte(uint8_t byte);
+    uint32_t writeDownloadByte(uint8_t byte);
+    uint32_t writeCharacter();
+    void clearWindow(uint8_t window);
+    void advanceLine();
+    void writeRamByte(uint16_t x, uint8_t row, uint8_t value);
+    uint16_t ramIndex(uint16_t x, uint8_t row) const;
+    void retireCompleted(uint32_t nowUs);
+
+    Timing timing_;
+    uint8_t ram_[RAM_SIZE];
+
+    uint8_t command_[16];
+    uint8_t commandLength_;
+
+    // Real-time bit image currently being streamed.
+    uint32_t imageRemaining_;
+    uint16_t imageX_;
+    uint8_t imageY_;
+    uint16_t imageWidth_;
+    uint8_t imageByteRows_;
+    uint16_t imageColumn_;
+    uint8_t imageRow_;
+
+    // Download character definition (ESC &) currently being streamed.
+    bool downloadActive_;
+    uint16_t downloadCode_;
+    uint8_t downloadLast_;
+    uint8_t downloadHeight_;   // bytes per column: 1 for 5x7, 2 for 10x14
+    uint8_t downloadWidth_;    // columns of the current character, 0 until its x byte arrived
+    uint8_t downloadReceived_;
+
+    bool downloadEnabled_;
+    uint8_t downloadDefined_[32]; // bit per character code
+    uint8_t downloadGlyphs_[256][DOWNLOAD_WIDTH];
+
+    uint16_t baseWidth_;
+    Window windows_[5];
+    uint8_t window_;
+    uint16_t cursorX_;
+    uint8_t cursorY_;
+    uint8_t writeLogic_;
+    uint8_t luminance_;
+    uint8_t font_;
+    uint8_t characterCode_;
+    uint8_t magnificationH_;
+    uint8_t magnificationV_;
+    uint16_t scrollBytes_;
+
+    // Completion times of the bytes still sitting in the input buffer (a FIFO ring).
+    uint32_t pending_[MAX_INPUT_BUFFER];
+    uint8_t pendingHead_;
+    uint8_t pendingCount_;
+    uint32_t lastCompletionUs_;
+
+    uint32_t bytesReceived_;
+    uint32_t commandsExecuted_;
+    uint32_t charactersWritten_;
+    uint32_t imageBytesWritten_;
+    uint32_t downloadsDefined_;
+    uint32_t overruns_;
+};
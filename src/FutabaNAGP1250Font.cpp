@@ -0,0 +1,404 @@
+#include "FutabaNAGP1250Font.h"
+
+#include <string.h>
+
+// Glyph cache entries per text renderer (a power of two). Each entry takes 20 bytes of RAM.
+// Set it as a library build flag; the cache is allocated by the constructor, so the renderer's
+// layout is the same whatever value the library was built with.
+#ifndef FUTABA_NAGP1250_GLYPH_CACHE_SIZE
+#ifdef __AVR__
+#define FUTABA_NAGP1250_GLYPH_CACHE_SIZE 8
+#else
+#define FUTABA_NAGP1250_GLYPH_CACHE_SIZE 32
+#endif
+#endif
+
+static_assert(FUTABA_NAGP1250_GLYPH_CACHE_SIZE > 0 && FUTABA_NAGP1250_GLYPH_CACHE_SIZE <= 128 &&
+                  (FUTABA_NAGP1250_GLYPH_CACHE_SIZE & (FUTABA_NAGP1250_GLYPH_CACHE_SIZE - 1)) == 0,
+              "FUTABA_NAGP1250_GLYPH_CACHE_SIZE must be a power of two up to 128");
+
+namespace {
+
+// ASCII 0x20..0x7E, five columns per glyph, MSB on top.
+const uint8_t kFont5x7[] PROGMEM = {
+    0x00, 0x00, 0x00, 0x00, 0x00, // space
+    0x00, 0x00, 0xFA, 0x00, 0x00, // !
+    0x00, 0xE0, 0x00, 0xE0, 0x00, // "
+    0x28, 0xFE, 0x28, 0xFE, 0x28, // #
+    0x24, 0x54, 0xFE, 0x54, 0x48, // $
+    0xC4, 0xC8, 0x10, 0x26, 0x46, // %
+    0x6C, 0x92, 0xAA, 0x44, 0x0A, // &
+    0x00, 0xA0, 0xC0, 0x00, 0x00, // '
+    0x00, 0x38, 0x44, 0x82, 0x00, // (
+    0x00, 0x82, 0x44, 0x38, 0x00, // )
+    0x10, 0x54, 0x38, 0x54, 0x10, // *
+    0x10, 0x10, 0x7C, 0x10, 0x10, // +
+    0x00, 0x0A, 0x0C, 0x00, 0x00, // ,
+    0x10, 0x10, 0x10, 0x10, 0x10, // -
+    0x00, 0x06, 0x06, 0x00, 0x00, // .
+    0x04, 0x08, 0x10, 0x20, 0x40, // /
+    0x7C, 0x8A, 0x92, 0xA2, 0x7C, // 0
+    0x00, 0x42, 0xFE, 0x02, 0x00, // 1
+    0x42, 0x86, 0x8A, 0x92, 0x62, // 2
+    0x84, 0x82, 0xA2, 0xD2, 0x8C, // 3
+    0x18, 0x28, 0x48, 0xFE, 0x08, // 4
+    0xE4, 0xA2, 0xA2, 0xA2, 0x9C, // 5
+    0x3C, 0x52, 0x92, 0x92, 0x0C, // 6
+    0x80, 0x8E, 0x90, 0xA0, 0xC0, // 7
+    0x6C, 0x92, 0x92, 0x92, 0x6C, // 8
+    0x60, 0x92, 0x92, 0x94, 0x78, // 9
+    0x00, 0x6C, 0x6C, 0x00, 0x00, // :
+    0x00, 0x6A, 0x6C, 0x00, 0x00, // ;
+    0x10, 0x28, 0x44, 0x82, 0x00, // <
+    0x28, 0x28, 0x28, 0x28, 0x28, // =
+    0x00, 0x82, 0x44, 0x28, 0x10, // >
+    0x40, 0x80, 0x8A, 0x90, 0x60, // ?
+    0x4C, 0x92, 0x9E, 0x82, 0x7C, // @
+    0x7E, 0x88, 0x88, 0x88, 0x7E, // A
+    0xFE, 0x92, 0x92, 0x92, 0x6C, // B
+    0x7C, 0x82, 0x82, 0x82, 0x44, // C
+    0xFE, 0x82, 0x82, 0x44, 0x38, // D
+    0xFE, 0x92, 0x92, 0x92, 0x82, // E
+    0xFE, 0x90, 0x90, 0x90, 0x80, // F
+    0x7C, 0x82, 0x92, 0x92, 0x5E, // G
+    0xFE, 0x10, 0x10, 0x10, 0xFE, // H
+    0x00, 0x82, 0xFE, 0x82, 0x00, // I
+    0x04, 0x02, 0x82, 0xFC, 0x80, // J
+    0xFE, 0x10, 0x28, 0x44, 0x82, // K
+    0xFE, 0x02, 0x02, 0x02, 0x02, // L
+    0xFE, 0x40, 0x30, 0x40, 0xFE, // M
+    0xFE, 0x20, 0x10, 0x08, 0xFE, // N
+    0x7C, 0x82, 0x82, 0x82, 0x7C, // O
+    0xFE, 0x90, 0x90, 0x90, 0x60, // P
+    0x7C, 0x82, 0x8A, 0x84, 0x7A, // Q
+    0xFE, 0x90, 0x98, 0x94, 0x62, // R
+    0x62, 0x92, 0x92, 0x92, 0x8C, // S
+    0x80, 0x80, 0xFE, 0x80, 0x80, // T
+    0xFC, 0x02, 0x02, 0x02, 0xFC, // U
+    0xF8, 0x04, 0x02, 0x04, 0xF8, // V
+    0xFC, 0x02, 0x1C, 0x02, 0xFC, // W
+    0xC6, 0x28, 0x10, 0x28, 0xC6, // X
+    0xE0, 0x10, 0x0E, 0x10, 0xE0, // Y
+    0x86, 0x8A, 0x92, 0xA2, 0xC2, // Z
+    0x00, 0xFE, 0x82, 0x82, 0x00, // [
+    0x40, 0x20, 0x10, 0x08, 0x04, // backslash
+    0x00, 0x82, 0x82, 0xFE, 0x00, // ]
+    0x20, 0x40, 0x80, 0x40, 0x20, // ^
+    0x02, 0x02, 0x02, 0x02, 0x02, // _
+    0x00, 0x80, 0x40, 0x20, 0x00, // `
+    0x04, 0x2A, 0x2A, 0x2A, 0x1E, // a
+    0xFE, 0x12, 0x22, 0x22, 0x1C, // b
+    0x1C, 0x22, 0x22, 0x22, 0x04, // c
+    0x1C, 0x22, 0x22, 0x12, 0xFE, // d
+    0x1C, 0x2A, 0x2A, 0x2A, 0x18, // e
+    0x10, 0x7E, 0x90, 0x80, 0x40, // f
+    0x30, 0x4A, 0x4A, 0x4A, 0x7C, // g
+    0xFE, 0x10, 0x20, 0x20, 0x1E, // h
+    0x00, 0x22, 0xBE, 0x02, 0x00, // i
+    0x04, 0x02, 0x22, 0xBC, 0x00, // j
+    0xFE, 0x08, 0x14, 0x22, 0x00, // k
+    0x00, 0x82, 0xFE, 0x02, 0x00, // l
+    0x3E, 0x20, 0x18, 0x20, 0x1E, // m
+    0x3E, 0x10, 0x20, 0x20, 0x1E, // n
+    0x1C, 0x22, 0x22, 0x22, 0x1C, // o
+    0x3E, 0x28, 0x28, 0x28, 0x10, // p
+    0x10, 0x28, 0x28, 0x18, 0x3E, // q
+    0x3E, 0x10, 0x20, 0x20, 0x10, // r
+    0x12, 0x2A, 0x2A, 0x2A, 0x04, // s
+    0x20, 0xFC, 0x22, 0x02, 0x04, // t
+    0x3C, 0x02, 0x02, 0x04, 0x3E, // u
+    0x38, 0x04, 0x02, 0x04, 0x38, // v
+    0x3C, 0x02, 0x0C, 0x02, 0x3C, // w
+    0x22, 0x14, 0x08, 0x14, 0x22, // x
+    0x30, 0x0A, 0x0A, 0x0A, 0x3C, // y
+    0x22, 0x26, 0x2A, 0x32, 0x22, // z
+    0x00, 0x10, 0x6C, 0x82, 0x00, // {
+    0x00, 0x00, 0xFE, 0x00, 0x00, // |
+    0x00, 0x82, 0x6C, 0x10, 0x00, // }
+    0x10, 0x20, 0x10, 0x08, 0x10, // ~
+};
+
+constexpr uint8_t kMaxByteRows = FutabaNAGP1250Framebuffer::MAX_HEIGHT / 8;
+
+// Clipped destination of one drawString() call, plus the placement of the current line.
+struct Target {
+    FutabaNAGP1250Framebuffer* frame;
+    uint8_t frameRows;
+    int16_t originX; // screen column of buffer column 0; x0/x1 and pens are screen columns
+    int16_t x0;
+    int16_t x1;
+    int16_t y0;
+    int16_t y1;
+    uint8_t clip[kMaxByteRows]; // writable bits per framebuffer byte row
+    bool on;
+    bool opaque;
+
+    int16_t row0;  // framebuffer byte row of the glyph's first byte (may be off the buffer)
+    uint8_t shift; // pixel offset of the glyph's top row within row0
+    uint8_t rows;  // byte rows a shifted glyph column covers
+    uint8_t box[kMaxByteRows + 1];
+};
+
+// Moves a packed column of `rows` bytes down by `shift` pixels; the result has one more byte
+// when `shift` is not zero.
+void shiftColumn(const uint8_t* flashColumn, uint8_t rows, uint8_t shift, uint8_t* out) {
+    uint8_t carry = 0;
+    for (uint8_t r = 0; r < rows; ++r) {
+        const uint8_t bits = pgm_read_byte(flashColumn + r);
+        out[r] = carry | static_cast<uint8_t>(bits >> shift);
+        carry = shift ? static_cast<uint8_t>(bits << (8 - shift)) : 0;
+    }
+    if (shift) {
+        out[rows] = carry;
+    }
+}
+
+void placeLine(Target& target, const FutabaNAGP1250Font& font, int16_t top) {
+    target.row0 = static_cast<int16_t>(top >= 0 ? top / 8 : -((7 - top) / 8));
+    target.shift = static_cast<uint8_t>(top - target.row0 * 8);
+    target.rows = static_cast<uint8_t>(font.byteRows() + (target.shift ? 1 : 0));
+
+    // Glyph cell mask: `height` bits from the top of the column, shifted like the glyphs.
+    uint8_t cell[kMaxByteRows];
+    uint8_t remaining = font.height;
+    for (uint8_t r = 0; r < font.byteRows(); ++r) {
+        cell[r] = remaining >= 8 ? 0xFF : static_cast<uint8_t>(0xFF << (8 - remaining));
+        remaining = remaining >= 8 ? remaining - 8 : 0;
+    }
+    uint8_t carry = 0;
+    for (uint8_t r = 0; r < font.byteRows(); ++r) {
+        target.box[r] = carry | static_cast<uint8_t>(cell[r] >> target.shift);
+        carry = target.shift ? static_cast<uint8_t>(cell[r] << (8 - target.shift)) : 0;
+    }
+    if (target.shift) {
+        target.box[font.byteRows()] = carry;
+    }
+}
+
+// Writes one glyph column (nullptr for a blank spacing column) at `x`, marking changed bytes.
+void writeColumn(const Target& target, int16_t x, const uint8_t* bits) {
+    if (x < target.x0 || x > target.x1) {
+        return;
+    }
+    x -= target.originX;
+    uint8_t* column = target.frame->data() + static_cast<size_t>(x) * target.frameRows;
+    for (uint8_t r = 0; r < target.rows; ++r) {
+        const int16_t row = target.row0 + r;
+        if (row < 0 || row >= target.frameRows) {
+            continue;
+        }
+        const uint8_t set = bits ? (bits[r] & target.clip[row]) : 0;
+        const uint8_t cover = target.opaque ? (target.box[r] & target.clip[row]) : set;
+        const uint8_t cell = column[row];
+        const uint8_t updated = target.on ? ((cell & ~cover) | set) : ((cell | cover) & ~set);
+        if (updated != cell) {
+            column[row] = updated;
+            target.frame->markColumnDirty(x, static_cast<uint8_t>(row));
+        }
+    }
+}
+
+} // namespace
+
+const FutabaNAGP1250Font FutabaNAGP1250Font::FONT_5X7 = {kFont5x7, nullptr, 0x20, 0x7E, 5, 7, 1, 1};
+
+FutabaNAGP1250TextRenderer::FutabaNAGP1250TextRenderer(const FutabaNAGP1250Font& font)
+    : font_(&font),
+      opaque_(false),
+      clipped_(false),
+      clipX0_(0),
+      clipY0_(0),
+      clipX1_(-1),
+      clipY1_(-1),
+      cache_(FUTABA_NAGP1250_GLYPH_CACHE_SIZE),
+      cacheHits_(0),
+      cacheMisses_(0) {
+    clearCache();
+}
+
+void FutabaNAGP1250TextRenderer::setClip(int16_t x, int16_t y, uint16_t w, uint16_t h) {
+    clipped_ = true;
+    clipX0_ = x;
+    clipY0_ = y;
+    clipX1_ = static_cast<int16_t>(constrain(static_cast<int32_t>(x) + w - 1, INT16_MIN, INT16_MAX));
+    clipY1_ = static_cast<int16_t>(constrain(static_cast<int32_t>(y) + h - 1, INT16_MIN, INT16_MAX));
+}
+
+void FutabaNAGP1250TextRenderer::clearClip() {
+    clipped_ = false;
+}
+
+void FutabaNAGP1250TextRenderer::clearCache() {
+    for (CacheEntry& entry : cache_) {
+        entry.font = nullptr;
+    }
+}
+
+int16_t FutabaNAGP1250TextRenderer::drawText(FutabaNAGP1250Framebuffer& frame, int16_t x, int16_t y,
+                                             const char* text, bool on) {
+    return drawString(frame, x, y, text, false, on);
+}
+
+int16_t FutabaNAGP1250TextRenderer::drawText(FutabaNAGP1250Framebuffer& frame, int16_t x, int16_t y,
+                                             const __FlashStringHelper* text, bool on) {
+    return drawString(frame, x, y, reinterpret_cast<const char*>(text), true, on);
+}
+
+int16_t FutabaNAGP1250TextRenderer::drawChar(FutabaNAGP1250Framebuffer& frame, int16_t x, int16_t y, char c,
+                                             bool on) {
+    const char text[2] = {c, '\0'};
+    return drawString(frame, x, y, text, false, on);
+}
+
+const uint8_t* FutabaNAGP1250TextRenderer::cachedGlyph(uint8_t code, uint8_t shift, uint8_t rows) {
+    CacheEntry& entry = cache_[(code + shift * 5u) & (cache_.size() - 1)];
+    if (entry.font == font_ && entry.code == code && entry.shift == shift) {
+        ++cacheHits_;
+        return entry.columns;
+    }
+    ++cacheMisses_;
+    const uint8_t fontRows = font_->byteRows();
+    const uint8_t* source = font_->glyph(code);
+    const uint8_t width = font_->glyphWidth(code);
+    for (uint8_t c = 0; c < width; ++c) {
+        shiftColumn(source + c * fontRows, fontRows, shift, entry.columns + c * rows);
+    }
+    entry.font = font_;
+    entry.code = code;
+    entry.shift = shift;
+    return entry.columns;
+}
+
+int16_t FutabaNAGP1250TextRenderer::drawString(FutabaNAGP1250Framebuffer& frame, int16_t x, int16_t y,
+                                               const char* text, bool flash, bool on) {
+    const FutabaNAGP1250Font& font = *font_;
+    const uint8_t fontRows = font.byteRows();
+    if (!text || fontRows == 0 || fontRows > kMaxByteRows) {
+        return x;
+    }
+
+    Target target;
+    target.frame = &frame;
+    target.frameRows = static_cast<uint8_t>(frame.byteRows());
+    target.originX = frame.originX();
+    target.x0 = target.originX;
+    target.y0 = 0;
+    target.x1 = static_cast<int16_t>(target.originX + frame.width() - 1);
+    target.y1 = static_cast<int16_t>(frame.height() - 1);
+    if (clipped_) {
+        target.x0 = max(target.x0, clipX0_);
+        target.y0 = max(target.y0, clipY0_);
+        target.x1 = min(target.x1, clipX1_);
+        target.y1 = min(target.y1, clipY1_);
+    }
+    for (uint8_t row = 0; row < target.frameRows; ++row) {
+        const int16_t top = max(target.y0, static_cast<int16_t>(row * 8)) - row * 8;
+        const int16_t bottom = min(target.y1, static_cast<int16_t>(row * 8 + 7)) - row * 8;
+        target.clip[row] = top > bottom ? 0 : static_cast<uint8_t>((0xFF >> top) & (0xFF << (7 - bottom)));
+    }
+    target.on = on;
+    target.opaque = opaque_;
+
+    int16_t lineTop = y;
+    placeLine(target, font, lineTop);
+    bool visible = lineTop <= target.y1 && lineTop + font.height > target.y0;
+
+    const bool cacheable = static_cast<uint16_t>(font.width) * (fontRows + 1) <= CACHE_GLYPH_BYTES;
+    uint8_t scratch[kMaxByteRows + 1];
+    int16_t pen = x;
+    for (const char* p = text;; ++p) {
+        const uint8_t code = flash ? pgm_read_byte(p) : static_cast<uint8_t>(*p);
+        if (code == '\0') {
+            break;
+        }
+        if (code == '\n') {
+            pen = x;
+            lineTop = static_cast<int16_t>(lineTop + font.lineHeight());
+            placeLine(target, font, lineTop);
+            visible = lineTop <= target.y1 && lineTop + font.height > target.y0;
+            continue;
+        }
+        const uint8_t width = font.glyphWidth(code);
+        if (width == 0) {
+            continue;
+        }
+        const int16_t advance = width + font.spacing;
+        if (visible && pen <= target.x1 && pen + advance > target.x0) {
+            const uint8_t first = static_cast<uint8_t>(constrain(target.x0 - pen, 0, static_cast<int16_t>(width)));
+            const uint8_t last = static_cast<uint8_t>(constrain(target.x1 - pen + 1, 0, static_cast<int16_t>(width)));
+            if (cacheable) {
+                const uint8_t* columns = cachedGlyph(code, target.shift, target.rows);
+                for (uint8_t c = first; c < last; ++c) {
+                    writeColumn(target, pen + c, columns + c * target.rows);
+                }
+            } else {
+                const uint8_t* source = font.glyph(code);
+                for (uint8_t c = first; c < last; ++c) {
+                    shiftColumn(source + c * fontRows, fontRows, target.shift, scratch);
+                    writeColumn(target, pen + c, scratch);
+                }
+            }
+            if (opaque_) {
+                for (uint8_t c = 0; c < font.spacing; ++c) {
+                    writeColumn(target, pen + width + c, nullptr);
+                }
+            }
+        }
+        pen = static_cast<int16_t>(pen + advance);
+    }
+    return pen;
+}
+
+uint16_t FutabaNAGP1250TextRenderer::measureText(const char* text) const {
+    return text ? measureText(text, strlen(text)) : 0;
+}
+
+uint16_t FutabaNAGP1250TextRenderer::measureText(const char* text, size_t length) const {
+    uint16_t widest = 0;
+    uint16_t line = 0;
+    for (size_t i = 0; i <= length; ++i) {
+        if (i == length || text[i] == '\n') {
+            // The last glyph's spacing is not part of the text.
+            const uint16_t width = line ? static_cast<uint16_t>(line - font_->spacing) : 0;
+            widest = max(widest, width);
+            line = 0;
+            continue;
+        }
+        const uint8_t width = font_->glyphWidth(static_cast<uint8_t>(text[i]));
+        if (width) {
+            line = static_cast<uint16_t>(line + width + font_->spacing);
+        }
+    }
+    return widest;
+}
+
+uint16_t FutabaNAGP1250TextRenderer::textHeight(const char* text) const {
+    if (!text || !*text) {
+        return 0;
+    }
+    uint16_t lines = 1;
+    for (const char* p = text; *p; ++p) {
+        if (*p == '\n') {
+            ++lines;
+        }
+    }
+    return static_cast<uint16_t>(lines * font_->lineHeight() - font_->lineSpacing);
+}
+
+size_t FutabaNAGP1250TextRenderer::fitText(const char* text, uint16_t maxWidth) const {
+    if (!text) {
+        return 0;
+    }
+    uint16_t line = 0;
+    size_t count = 0;
+    for (; text[count] && text[count] != '\n'; ++count) {
+        const uint8_t width = font_->glyphWidth(static_cast<uint8_t>(text[count]));
+        if (width && line + width > maxWidth) {
+            break;
+        }
+        if (width) {
+            line = static_cast<uint16_t>(line + width + font_->spacing);
+        }
+    }
+    return count;
+}
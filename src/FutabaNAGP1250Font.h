@@ -0,0 +1,122 @@
+#pragma once
+
+#include <Arduino.h>
+#include <vector>
+
+#include "FutabaNAGP1250Framebuffer.h"
+
+/**
+ * Bitmap font stored in the display's packed column layout.
+ *
+ * Glyphs `first..last` are stored back to back in PROGMEM, `width * byteRows()` bytes each:
+ * column by column, `byteRows()` bytes per column from top to bottom, MSB on top. That is the
+ * framebuffer layout, so a glyph drawn on a byte row boundary is copied without any bit
+ * shuffling. Proportional fonts add a PROGMEM table with one advance width per glyph and keep
+ * their glyphs left-aligned in the `width` columns.
+ */
+struct FutabaNAGP1250Font {
+    const uint8_t* bitmap;
+    const uint8_t* widths; // nullptr for fixed-width fonts
+    uint8_t first;
+    uint8_t last;
+    uint8_t width;
+    uint8_t height;
+    uint8_t spacing;     // blank columns after each glyph
+    uint8_t lineSpacing; // blank rows between lines
+
+    uint8_t byteRows() const { return static_cast<uint8_t>((height + 7) >> 3); }
+    uint8_t lineHeight() const { return static_cast<uint8_t>(height + lineSpacing); }
+    bool contains(uint8_t code) const { return code >= first && code <= last; }
+    // Columns of ink for `code`, 0 if the font does not contain it.
+    uint8_t glyphWidth(uint8_t code) const {
+        if (!contains(code)) {
+            return 0;
+        }
+        return widths ? pgm_read_byte(widths + (code - first)) : width;
+    }
+    const uint8_t* glyph(uint8_t code) const {
+        return bitmap + static_cast<size_t>(code - first) * width * byteRows();
+    }
+
+    // Classic 5x7 ASCII font (0x20..0x7E) with one column of spacing and an 8 pixel line
+    // height, so four lines fill the 32 pixel high display on byte row boundaries.
+    static const FutabaNAGP1250Font FONT_5X7;
+};
+
+/**
+ * Draws text from a `FutabaNAGP1250Font` straight into a packed framebuffer.
+ *
+ * Text and graphics then end up in the same buffer and go out as one bit image, or as the few
+ * dirty regions `FutabaNAGP1250::flush` sends, instead of a bit image plus hardware text and
+ * write-logic commands layered on top. Only bytes that actually change are written and marked
+ * dirty, so redrawing a label that did not change costs nothing on the next flush.
+ *
+ * Glyphs that do not start on a byte row boundary have to be shifted across two byte rows. The
+ * renderer keeps the most recently used glyphs in a small direct-mapped cache, already shifted
+ * for the row offset they were drawn at, so repeated characters are neither read from flash
+ * nor shifted again.
+ *
+ * Drawing is clipped to the framebuffer and to an optional clip rectangle. '\n' starts a new
+ * line at the original x; characters the font does not contain are skipped.
+ */
+class FutabaNAGP1250TextRenderer {
+public:
+    // Largest shifted glyph the cache holds (width * (byteRows + 1)); bigger ones are drawn
+    // uncached.
+    static constexpr uint8_t CACHE_GLYPH_BYTES = 16;
+
+    explicit FutabaNAGP1250TextRenderer(const FutabaNAGP1250Font& font = FutabaNAGP1250Font::FONT_5X7);
+
+    void setFont(const FutabaNAGP1250Font& font) { font_ = &font; }
+    const FutabaNAGP1250Font& font() const { return *font_; }
+
+    // Opaque text also paints the glyph cells, spacing included, with the background colour
+    // (the opposite of `on`), so it can be redrawn over old text without clearing first.
+    void setOpaque(bool opaque) { opaque_ = opaque; }
+    bool opaque() const { return opaque_; }
+
+    void setClip(int16_t x, int16_t y, uint16_t w, uint16_t h);
+    void clearClip();
+
+    // Draws `text` with its top-left corner at (x, y) and returns the x after the last glyph.
+    int16_t drawText(FutabaNAGP1250Framebuffer& frame, int16_t x, int16_t y, const char* text, bool on = true);
+    int16_t drawText(FutabaNAGP1250Framebuffer& frame, int16_t x, int16_t y, const __FlashStringHelper* text,
+                     bool on = true);
+    int16_t drawChar(FutabaNAGP1250Framebuffer& frame, int16_t x, int16_t y, char c, bool on = true);
+
+    // Width in pixels of the widest line (trailing spacing excluded), and height of all lines.
+    uint16_t measureText(const char* text) const;
+    uint16_t measureText(const char* text, size_t length) const;
+    uint16_t textHeight(const char* text) const;
+    // Number of characters from the start of `text` that fit in `maxWidth` on one line.
+    size_t fitText(const char* text, uint16_t maxWidth) const;
+
+    void clearCache();
+    // Entries in the glyph cache (FUTABA_NAGP1250_GLYPH_CACHE_SIZE, a library build flag).
+    uint8_t cacheSize() const { return static_cast<uint8_t>(cache_.size()); }
+    uint32_t cacheHits() const { return cacheHits_; }
+    uint32_t cacheMisses() const { return cacheMisses_; }
+
+private:
+    struct CacheEntry {
+        const FutabaNAGP1250Font* font;
+        uint8_t code;
+        uint8_t shift;
+        uint8_t columns[CACHE_GLYPH_BYTES];
+    };
+
+    int16_t drawString(FutabaNAGP1250Framebuffer& frame, int16_t x, int16_t y, const char* text, bool flash,
+                       bool on);
+    const uint8_t* cachedGlyph(uint8_t code, uint8_t shift, uint8_t rows);
+
+    const FutabaNAGP1250Font* font_;
+    bool opaque_;
+    bool clipped_;
+    int16_t clipX0_;
+    int16_t clipY0_;
+    int16_t clipX1_;
+    int16_t clipY1_;
+    std::vector<CacheEntry> cache_;
+    uint32_t cacheHits_;
+    uint32_t cacheMisses_;
+};
@@ -0,0 +1,236 @@
+#include "FutabaNAGP1250FrameCodec.h"
+
+#include "FutabaNAGP1250.h"
+
+FutabaNAGP1250FrameEncoder::FutabaNAGP1250FrameEncoder(uint16_t width, uint8_t byteRows)
+    : width_(width),
+      byteRows_(byteRows),
+      previous_(static_cast<size_t>(width) * byteRows, 0),
+      hasPrevious_(false) {}
+
+size_t FutabaNAGP1250FrameEncoder::maxEncodedSize(uint16_t width, uint8_t byteRows) {
+    const size_t length = static_cast<size_t>(width) * byteRows;
+    return HEADER_SIZE + length + (length + 127) / 128;
+}
+
+size_t FutabaNAGP1250FrameEncoder::encode(const FutabaNAGP1250Framebuffer& frame, uint8_t* out,
+                                          size_t capacity, bool forceKey) {
+    if (frame.width() != width_ || frame.byteRows() != byteRows_) {
+        return 0;
+    }
+    return encode(frame.data(), out, capacity, forceKey);
+}
+
+size_t FutabaNAGP1250FrameEncoder::encode(const uint8_t* frame, uint8_t* out, size_t capacity, bool forceKey) {
+    if (!frame || !out || capacity < maxEncodedSize(width_, byteRows_)) {
+        return 0;
+    }
+
+    // Sizing passes first, so only the smaller encoding is written out.
+    bool delta = false;
+    if (hasPrevious_ && !forceKey) {
+        delta = encodeRuns(frame, true, nullptr) < encodeRuns(frame, false, nullptr);
+    }
+
+    out[0] = delta ? FRAME_DELTA : FRAME_KEY;
+    out[1] = width_ & 0xFF;
+    out[2] = (width_ >> 8) & 0xFF;
+    out[3] = byteRows_;
+    const size_t length = HEADER_SIZE + encodeRuns(frame, delta, out + HEADER_SIZE);
+
+    memcpy(previous_.data(), frame, previous_.size());
+    hasPrevious_ = true;
+    return length;
+}
+
+size_t FutabaNAGP1250FrameEncoder::encodeRuns(const uint8_t* frame, bool delta, uint8_t* out) const {
+    const size_t length = previous_.size();
+    const uint8_t* previous = previous_.data();
+    auto at = [&](size_t i) -> uint8_t { return delta ? frame[i] ^ previous[i] : frame[i]; };
+    // A run of three or more ends a literal; shorter repeats are cheaper left inside it.
+    auto runOfThree = [&](size_t i) { return i + 2 < length && at(i) == at(i + 1) && at(i) == at(i + 2); };
+
+    size_t written = 0;
+    auto put = [&](uint8_t byte) {
+        if (out) out[written] = byte;
+        ++written;
+    };
+
+    size_t i = 0;
+    while (i < length) {
+        const uint8_t value = at(i);
+        size_t run = 1;
+        while (i + run < length && run < 129 && at(i + run) == value) {
+            ++run;
+        }
+        if (run >= 2) {
+            put(static_cast<uint8_t>(0x7E + run));
+            put(value);
+            i += run;
+            continue;
+        }
+
+        const size_t start = i;
+        size_t count = 0;
+        while (i < length && count < 128 && (count == 0 || !runOfThree(i))) {
+            ++i;
+            ++count;
+        }
+        put(static_cast<uint8_t>(count - 1));
+        for (size_t k = start; k < start + count; ++k) {
+            put(at(k));
+        }
+    }
+    return written;
+}
+
+FutabaNAGP1250FrameDecoder::FutabaNAGP1250FrameDecoder()
+    : target_(nullptr),
+      display_(nullptr),
+      state_(STATE_HEADER),
+      headerLength_(0),
+      runLength_(0),
+      delta_(false),
+      discard_(false),
+      width_(0),
+      byteRows_(0),
+      remaining_(0),
+      position_(0),
+      scratchLength_(0),
+      framesDecoded_(0),
+      framesRejected_(0) {}
+
+void FutabaNAGP1250FrameDecoder::begin(FutabaNAGP1250Framebuffer& target) {
+    target_ = &target;
+    display_ = nullptr;
+    state_ = STATE_HEADER;
+    headerLength_ = 0;
+}
+
+void FutabaNAGP1250FrameDecoder::begin(FutabaNAGP1250& display) {
+    target_ = nullptr;
+    display_ = &display;
+    state_ = STATE_HEADER;
+    headerLength_ = 0;
+}
+
+uint16_t FutabaNAGP1250FrameDecoder::write(const uint8_t* data, size_t length) {
+    uint16_t completed = 0;
+    for (size_t i = 0; i < length; ++i) {
+        const uint8_t byte = data[i];
+        switch (state_) {
+            case STATE_HEADER:
+                header_[headerLength_++] = byte;
+                if (headerLength_ == FutabaNAGP1250FrameEncoder::HEADER_SIZE) {
+                    headerLength_ = 0;
+                    startFrame();
+                }
+                break;
+            case STATE_CONTROL:
+                if (byte < 0x80) {
+                    runLength_ = byte + 1;
+                    state_ = STATE_LITERAL;
+                } else {
+                    runLength_ = byte - 0x7E;
+                    state_ = STATE_REPEAT;
+                }
+                break;
+            case STATE_LITERAL:
+                emit(byte, 1);
+                if (--runLength_ == 0) {
+                    state_ = STATE_CONTROL;
+                }
+                break;
+            case STATE_REPEAT:
+                emit(byte, runLength_);
+                state_ = STATE_CONTROL;
+                break;
+        }
+        if (state_ != STATE_HEADER && remaining_ == 0) {
+            finishFrame();
+            ++completed;
+        }
+    }
+    return completed;
+}
+
+void FutabaNAGP1250FrameDecoder::startFrame() {
+    const uint8_t type = header_[0];
+    width_ = header_[1] | (header_[2] << 8);
+    byteRows_ = header_[3];
+    delta_ = type == FutabaNAGP1250FrameEncoder::FRAME_DELTA;
+    remaining_ = static_cast<size_t>(width_) * byteRows_;
+    position_ = 0;
+    scratchLength_ = 0;
+    state_ = STATE_CONTROL;
+
+    bool valid = type == FutabaNAGP1250FrameEncoder::FRAME_KEY || delta_;
+    if (target_) {
+        valid = valid && width_ == target_->width() && byteRows_ == target_->byteRows();
+    } else if (display_) {
+        valid = valid && width_ <= FutabaNAGP1250::WIDTH_EXTENDED && byteRows_ <= FutabaNAGP1250::HEIGHT / 8;
+    }
+    discard_ = !valid || remaining_ == 0;
+    if (!valid) {
+        ++framesRejected_;
+    }
+
+    if (display_ && !discard_) {
+        // A key frame replaces what is shown, which under OR or AND logic it could not.
+        display_->setWriteLogic(delta_ ? FutabaNAGP1250::WRITE_MODE_XOR : FutabaNAGP1250::WRITE_MODE_NORMAL);
+        display_->beginGraphicImageStream(width_, byteRows_);
+    }
+}
+
+void FutabaNAGP1250FrameDecoder::emit(uint8_t value, uint16_t count) {
+    if (count > remaining_) {
+        count = remaining_;
+    }
+    remaining_ -= count;
+    if (discard_) {
+        return;
+    }
+
+    if (target_) {
+        // XOR with zero changes nothing, which is what most of a delta frame is.
+        if (delta_ && value == 0) {
+            position_ += count;
+            return;
+        }
+        uint8_t* data = target_->data();
+        const uint8_t byteRows = byteRows_;
+        for (; count; --count, ++position_) {
+            const uint8_t updated = delta_ ? data[position_] ^ value : value;
+            if (updated != data[position_]) {
+                data[position_] = updated;
+                target_->markColumnDirty(position_ / byteRows, position_ % byteRows);
+            }
+        }
+    } else if (display_) {
+        for (; count; --count) {
+            scratch_[scratchLength_++] = value;
+            if (scratchLength_ == SCRATCH_SIZE) {
+                display_->writeGraphicImageStream(scratch_, scratchLength_);
+                scratchLength_ = 0;
+            }
+        }
+    }
+}
+
+void FutabaNAGP1250FrameDecoder::finishFrame() {
+    state_ = STATE_HEADER;
+    if (discard_) {
+        return;
+    }
+    if (display_) {
+        if (scratchLength_) {
+            display_->writeGraphicImageStream(scratch_, scratchLength_);
+            scratchLength_ = 0;
+        }
+        display_->endGraphicImageStream();
+        if (delta_) {
+            display_->setWriteLogic(FutabaNAGP1250::WRITE_MODE_NORMAL);
+        }
+    }
+    ++framesDecoded_;
+}
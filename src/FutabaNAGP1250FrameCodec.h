@@ -0,0 +1,109 @@
+#pragma once
+
+#include <Arduino.h>
+#include <vector>
+
+#include "FutabaNAGP1250Framebuffer.h"
+
+class FutabaNAGP1250;
+
+/**
+ * Compressed frame stream for packed 1bpp frames (the `FutabaNAGP1250Framebuffer` layout).
+ *
+ * Every frame starts with a 4 byte header: the frame type, the width (uint16, little endian)
+ * and the number of byte rows. The `width * byteRows` column-major bytes follow, run-length
+ * encoded: a control byte `c < 0x80` is followed by `c + 1` literal bytes, `c >= 0x80` by one
+ * byte that repeats `c - 0x7E` times (2..129). Key frames encode the frame bytes themselves,
+ * delta frames the XOR with the previous frame, which is mostly long zero runs for animations.
+ */
+class FutabaNAGP1250FrameEncoder {
+public:
+    static constexpr uint8_t FRAME_KEY = 'K';
+    static constexpr uint8_t FRAME_DELTA = 'D';
+    static constexpr uint8_t HEADER_SIZE = 4;
+
+    explicit FutabaNAGP1250FrameEncoder(uint16_t width = 140, uint8_t byteRows = 4);
+
+    // Worst-case encoded size of one frame, header included.
+    static size_t maxEncodedSize(uint16_t width, uint8_t byteRows);
+
+    // Encodes `frame` (`width * byteRows` packed bytes) as a key or delta frame, whichever is
+    // smaller, and remembers it as the reference for the next one. Returns the encoded size, or
+    // 0 if `capacity` is below maxEncodedSize().
+    size_t encode(const uint8_t* frame, uint8_t* out, size_t capacity, bool forceKey = false);
+    size_t encode(const FutabaNAGP1250Framebuffer& frame, uint8_t* out, size_t capacity, bool forceKey = false);
+
+    // Forgets the reference frame; the next frame is encoded as a key frame.
+    void reset() { hasPrevious_ = false; }
+
+    uint16_t width() const { return width_; }
+    uint8_t byteRows() const { return byteRows_; }
+
+private:
+    size_t encodeRuns(const uint8_t* frame, bool delta, uint8_t* out) const;
+
+    uint16_t width_;
+    uint8_t byteRows_;
+    std::vector<uint8_t> previous_;
+    bool hasPrevious_;
+};
+
+/**
+ * Streaming decoder for `FutabaNAGP1250FrameEncoder` output.
+ *
+ * Bytes can be fed in arbitrary chunks as they arrive from the input link. Frames are decoded
+ * either into a framebuffer (delta frames are XORed in place and only changed bytes are marked
+ * dirty, ready for `FutabaNAGP1250::flush`) or straight to the display through a small scratch
+ * buffer, with no framebuffer at all: key frames are sent with the NORMAL write logic and delta
+ * frames with XOR, so the display applies them to what it already shows. Whatever write logic
+ * the sketch had set, the display sink leaves it at NORMAL after each frame.
+ */
+class FutabaNAGP1250FrameDecoder {
+public:
+    static constexpr uint8_t SCRATCH_SIZE = 32;
+
+    FutabaNAGP1250FrameDecoder();
+
+    void begin(FutabaNAGP1250Framebuffer& target);
+    void begin(FutabaNAGP1250& display);
+
+    // Consumes encoded bytes; returns how many complete frames they finished.
+    uint16_t write(const uint8_t* data, size_t length);
+
+    bool inFrame() const { return state_ != STATE_HEADER || headerLength_ != 0; }
+    uint32_t framesDecoded() const { return framesDecoded_; }
+    // Frames skipped because of an unknown type or a size that does not match the framebuffer.
+    uint32_t framesRejected() const { return framesRejected_; }
+
+private:
+    enum State : uint8_t {
+        STATE_HEADER,
+        STATE_CONTROL,
+        STATE_LITERAL,
+        STATE_REPEAT,
+    };
+
+    void startFrame();
+    void emit(uint8_t value, uint16_t count);
+    void finishFrame();
+
+    FutabaNAGP1250Framebuffer* target_;
+    FutabaNAGP1250* display_;
+
+    State state_;
+    uint8_t header_[FutabaNAGP1250FrameEncoder::HEADER_SIZE];
+    uint8_t headerLength_;
+    uint8_t runLength_;
+    bool delta_;
+    bool discard_;
+    uint16_t width_;
+    uint8_t byteRows_;
+    size_t remaining_;
+    size_t position_;
+
+    uint8_t scratch_[SCRATCH_SIZE];
+    uint8_t scratchLength_;
+
+    uint32_t framesDecoded_;
+    uint32_t framesRejected_;
+};
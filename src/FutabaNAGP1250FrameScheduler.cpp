@@ -0,0 +1,103 @@
+#include "FutabaNAGP1250FrameScheduler.h"
+
+#include "FutabaNAGP1250.h"
+
+FutabaNAGP1250FrameScheduler::FutabaNAGP1250FrameScheduler(FutabaNAGP1250& display,
+                                                           FutabaNAGP1250Framebuffer& frame,
+                                                           float fps)
+    : display_(display),
+      frame_(frame),
+      render_(nullptr),
+      context_(nullptr),
+      periodUs_(0),
+      partialUploads_(true),
+      started_(false),
+      nextTickUs_(0),
+      index_(0) {
+    setTargetFps(fps);
+    resetStats();
+}
+
+void FutabaNAGP1250FrameScheduler::setRender(RenderCallback callback, void* context) {
+    render_ = callback;
+    context_ = context;
+}
+
+void FutabaNAGP1250FrameScheduler::setTargetFps(float fps) {
+    periodUs_ = fps > 0 ? max(static_cast<uint32_t>(1000000.0f / fps), static_cast<uint32_t>(1)) : 1000000;
+}
+
+bool FutabaNAGP1250FrameScheduler::service() {
+    uint32_t now = micros();
+    if (!started_) {
+        started_ = true;
+        nextTickUs_ = now;
+        index_ = 0;
+    }
+    if (static_cast<int32_t>(now - nextTickUs_) < 0) {
+        return false;
+    }
+
+    // Ticks that passed while the previous frame was still being drawn or sent are dropped.
+    const uint32_t missed = (now - nextTickUs_) / periodUs_;
+    if (missed) {
+        framesDropped_ += missed;
+        index_ += missed;
+        nextTickUs_ += missed * periodUs_;
+    }
+    const uint32_t tick = nextTickUs_;
+
+    if (render_) {
+        render_(frame_, index_, context_);
+    }
+    const uint32_t rendered = micros();
+    if (partialUploads_) {
+        display_.flush(frame_);
+    } else {
+        FutabaNAGP1250::Batch batch(display_);
+        display_.setCursorPosition(0, 0);
+        display_.displayGraphicImage(frame_);
+        frame_.clearDirty();
+    }
+    const uint32_t done = micros();
+
+    lastRenderUs_ = rendered - now;
+    lastTransmitUs_ = done - rendered;
+    latencies_[latencyHead_] = done - tick;
+    latencyHead_ = (latencyHead_ + 1) % LATENCY_SAMPLES;
+    if (latencyCount_ < LATENCY_SAMPLES) {
+        ++latencyCount_;
+    }
+
+    ++framesShown_;
+    ++index_;
+    nextTickUs_ += periodUs_;
+    return true;
+}
+
+uint32_t FutabaNAGP1250FrameScheduler::latencyPercentile(uint8_t percent) const {
+    if (latencyCount_ == 0) {
+        return 0;
+    }
+    // Insertion sort of a copy; the window is small enough that this beats anything cleverer.
+    uint32_t sorted[LATENCY_SAMPLES];
+    for (uint8_t i = 0; i < latencyCount_; ++i) {
+        const uint32_t value = latencies_[i];
+        uint8_t j = i;
+        for (; j > 0 && sorted[j - 1] > value; --j) {
+            sorted[j] = sorted[j - 1];
+        }
+        sorted[j] = value;
+    }
+    const uint8_t rank = (static_cast<uint16_t>(latencyCount_ - 1) * min(percent, static_cast<uint8_t>(100)) + 50) / 100;
+    return sorted[rank];
+}
+
+void FutabaNAGP1250FrameScheduler::resetStats() {
+    framesShown_ = 0;
+    framesDropped_ = 0;
+    lastRenderUs_ = 0;
+    lastTransmitUs_ = 0;
+    latencyHead_ = 0;
+    latencyCount_ = 0;
+}
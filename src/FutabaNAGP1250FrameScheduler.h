@@ -0,0 +1,74 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include "FutabaNAGP1250Framebuffer.h"
+
+class FutabaNAGP1250;
+
+/**
+ * Fixed frame rate loop for framebuffer animations.
+ *
+ * Frames are due on a fixed grid of `1 / fps` ticks from the first service() call. When a tick
+ * is due the render callback draws frame `index` into the framebuffer, which is then uploaded
+ * (changed regions only by default). If rendering plus transmitting falls behind, the ticks that
+ * were missed are dropped and the next render is given the index of the current tick, so the
+ * animation keeps its real-time speed instead of slowing down with the link.
+ *
+ * Per frame, the latency from the tick to the end of the upload is recorded; percentiles over
+ * the last `LATENCY_SAMPLES` frames show how close the link is to saturation.
+ */
+class FutabaNAGP1250FrameScheduler {
+public:
+    static constexpr uint8_t LATENCY_SAMPLES = 64;
+
+    typedef void (*RenderCallback)(FutabaNAGP1250Framebuffer& frame, uint32_t index, void* context);
+
+    FutabaNAGP1250FrameScheduler(FutabaNAGP1250& display, FutabaNAGP1250Framebuffer& frame, float fps = 30);
+
+    void setRender(RenderCallback callback, void* context = nullptr);
+    void setTargetFps(float fps);
+    float targetFps() const { return 1000000.0f / periodUs_; }
+    // Upload only the dirty regions (default) or always the whole frame.
+    void setPartialUploads(bool enabled) { partialUploads_ = enabled; }
+    // Restarts the tick grid at index 0 on the next service() call.
+    void restart() { started_ = false; }
+
+    // Call as often as possible from loop(); renders and uploads when a frame is due and returns
+    // true if it did.
+    bool service();
+
+    // Index of the next frame to be rendered (ticks elapsed, shown or dropped).
+    uint32_t frameIndex() const { return index_; }
+    uint32_t framesShown() const { return framesShown_; }
+    uint32_t framesDropped() const { return framesDropped_; }
+    uint32_t lastRenderUs() const { return lastRenderUs_; }
+    uint32_t lastTransmitUs() const { return lastTransmitUs_; }
+    // True when the last frame's render plus upload took longer than a frame period.
+    bool saturated() const { return lastRenderUs_ + lastTransmitUs_ >= periodUs_; }
+
+    // Tick-to-uploaded latency in microseconds at percentile `percent` (0..100) of the recent
+    // frames, e.g. 50 for the median or 99 for the tail; 0 before the first frame.
+    uint32_t latencyPercentile(uint8_t percent) const;
+    void resetStats();
+
+private:
+    FutabaNAGP1250& display_;
+    FutabaNAGP1250Framebuffer& frame_;
+    RenderCallback render_;
+    void* context_;
+
+    uint32_t periodUs_;
+    bool partialUploads_;
+    bool started_;
+    uint32_t nextTickUs_;
+    uint32_t index_;
+
+    uint32_t framesShown_;
+    uint32_t framesDropped_;
+    uint32_t lastRenderUs_;
+    uint32_t lastTransmitUs_;
+    uint32_t latencies_[LATENCY_SAMPLES];
+    uint8_t latencyHead_;
+    uint8_t latencyCount_;
+};
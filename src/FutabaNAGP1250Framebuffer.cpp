@@ -0,0 +1,124 @@
+#include "FutabaNAGP1250Framebuffer.h"
+
+#include "FutabaNAGP1250.h"
+
+FutabaNAGP1250Framebuffer::FutabaNAGP1250Framebuffer(uint16_t width, uint16_t height)
+    : width_(constrain(width, static_cast<uint16_t>(1), static_cast<uint16_t>(MAX_WIDTH))),
+      height_(constrain(height, static_cast<uint16_t>(8), static_cast<uint16_t>(MAX_HEIGHT))),
+      byteRows_((height_ + 7) / 8),
+      originX_(0),
+      screenWidth_(0),
+      buffer_(static_cast<size_t>(width_) * byteRows_, 0) {
+    // The display contents are unknown until the first upload.
+    clearDirty();
+    markDirty();
+}
+
+void FutabaNAGP1250Framebuffer::clear() {
+    fill(false);
+}
+
+void FutabaNAGP1250Framebuffer::fill(bool on) {
+    const uint8_t value = on ? 0xFF : 0x00;
+    uint8_t* cell = buffer_.data();
+    for (uint16_t x = 0; x < width_; ++x) {
+        for (uint8_t row = 0; row < byteRows_; ++row, ++cell) {
+            if (*cell != value) {
+                *cell = value;
+                markColumnDirty(x, row);
+            }
+        }
+    }
+}
+
+void FutabaNAGP1250Framebuffer::fillRect(int16_t x, int16_t y, uint16_t w, uint16_t h, bool on) {
+    x -= originX_;
+    const int16_t x0 = max(x, static_cast<int16_t>(0));
+    const int16_t y0 = max(y, static_cast<int16_t>(0));
+    const int16_t x1 = min(static_cast<int32_t>(x) + w - 1, static_cast<int32_t>(width_) - 1);
+    const int16_t y1 = min(static_cast<int32_t>(y) + h - 1, static_cast<int32_t>(height_) - 1);
+    if (w == 0 || h == 0 || x1 < x0 || y1 < y0) {
+        return;
+    }
+
+    // One mask per covered byte row, MSB on top; rows strictly inside the rectangle are 0xFF.
+    const uint8_t firstRow = y0 >> 3;
+    const uint8_t lastRow = y1 >> 3;
+    uint8_t masks[MAX_HEIGHT / 8];
+    for (uint8_t row = firstRow; row <= lastRow; ++row) {
+        const uint8_t top = row == firstRow ? (y0 & 7) : 0;
+        const uint8_t bottom = row == lastRow ? (y1 & 7) : 7;
+        masks[row] = static_cast<uint8_t>((0xFF >> top) & (0xFF << (7 - bottom)));
+    }
+
+    uint8_t* column = buffer_.data() + static_cast<size_t>(x0) * byteRows_;
+    for (int16_t cx = x0; cx <= x1; ++cx, column += byteRows_) {
+        for (uint8_t row = firstRow; row <= lastRow; ++row) {
+            applyMask(column[row], masks[row], on, cx, row);
+        }
+    }
+}
+
+bool FutabaNAGP1250Framebuffer::loadBitmap(const std::vector<uint8_t>& bitmap) {
+    if (bitmap.size() != static_cast<size_t>(width_) * height_) {
+        return false;
+    }
+
+    // Pack with the block kernel, then only mark the bytes that differ from what is held.
+    const std::vector<uint8_t> packed = FutabaNAGP1250::packBitmap(bitmap, width_, height_);
+    const uint8_t* in = packed.data();
+    uint8_t* out = buffer_.data();
+    for (uint16_t x = 0; x < width_; ++x) {
+        for (uint8_t row = 0; row < byteRows_; ++row, ++in, ++out) {
+            if (*out != *in) {
+                *out = *in;
+                markColumnDirty(x, row);
+            }
+        }
+    }
+    return true;
+}
+
+bool FutabaNAGP1250Framebuffer::isDirty() const {
+    for (uint8_t row = 0; row < byteRows_; ++row) {
+        if (dirtyMax_[row] >= dirtyMin_[row]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool FutabaNAGP1250Framebuffer::dirtySpan(uint8_t byteRow, uint16_t& x0, uint16_t& x1) const {
+    if (byteRow >= byteRows_ || dirtyMax_[byteRow] < dirtyMin_[byteRow]) {
+        return false;
+    }
+    x0 = dirtyMin_[byteRow];
+    x1 = dirtyMax_[byteRow];
+    return true;
+}
+
+void FutabaNAGP1250Framebuffer::markDirty() {
+    markDirty(originX_, 0, width_, height_);
+}
+
+void FutabaNAGP1250Framebuffer::markDirty(int16_t x, int16_t y, uint16_t w, uint16_t h) {
+    x -= originX_;
+    const int16_t x0 = max(x, static_cast<int16_t>(0));
+    const int16_t y0 = max(y, static_cast<int16_t>(0));
+    const int16_t x1 = min(static_cast<int32_t>(x) + w - 1, static_cast<int32_t>(width_) - 1);
+    const int16_t y1 = min(static_cast<int32_t>(y) + h - 1, static_cast<int32_t>(height_) - 1);
+    if (w == 0 || h == 0 || x1 < x0 || y1 < y0) {
+        return;
+    }
+    for (uint8_t row = y0 >> 3; row <= (y1 >> 3); ++row) {
+        markColumnDirty(x0, row);
+        markColumnDirty(x1, row);
+    }
+}
+
+void FutabaNAGP1250Framebuffer::clearDirty() {
+    for (uint8_t row = 0; row < MAX_HEIGHT / 8; ++row) {
+        dirtyMin_[row] = INT16_MAX;
+        dirtyMax_[row] = -1;
+    }
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <Arduino.h>
+#include <vector>
+
+/**
+ * Packed 1bpp framebuffer stored in the NAGP1250 native bit-image layout.
+ *
+ * Pixels are kept column-major: every column holds `height / 8` bytes from top to bottom
+ * and the most significant bit of each byte is the topmost pixel. This is exactly what the
+ * real-time bit image command expects, so `FutabaNAGP1250::displayGraphicImage` can send the
+ * buffer as-is (560 bytes for 140x32, 1024 bytes for the 256x32 extended window).
+ *
+ * The framebuffer also records, per byte row, the column span that changed since the last
+ * `FutabaNAGP1250::flush`, so small updates can be uploaded as partial bit images. Writes
+ * made through `data()` bypass the tracking and must be reported with `markDirty`.
+ *
+ * A buffer narrower than the screen can cover any band of columns: `setOrigin(x)` makes buffer
+ * column 0 show screen column `x`. Pixel, fill and draw calls then take screen coordinates and
+ * clip to the band, which is how `FutabaNAGP1250StripRenderer` draws a full screen in a strip.
+ * `data()`, `markColumnDirty` and `dirtySpan` stay in buffer columns.
+ */
+class FutabaNAGP1250Framebuffer {
+public:
+    static constexpr uint16_t MAX_WIDTH = 256;
+    static constexpr uint16_t MAX_HEIGHT = 32;
+
+    FutabaNAGP1250Framebuffer(uint16_t width = 140, uint16_t height = MAX_HEIGHT);
+
+    uint16_t width() const { return width_; }
+    uint16_t height() const { return height_; }
+    uint16_t byteRows() const { return byteRows_; }
+    size_t size() const { return buffer_.size(); }
+
+    // Screen column shown by buffer column 0 (0 by default). Boxes are clamped to screen columns
+    // `0 .. screenWidth - 1` as they would be in a full-width buffer; 0 means the band is the
+    // right end of the screen.
+    void setOrigin(int16_t x, uint16_t screenWidth = 0) {
+        originX_ = x;
+        screenWidth_ = screenWidth;
+    }
+    int16_t originX() const { return originX_; }
+    uint16_t screenWidth() const { return screenWidth_ ? screenWidth_ : static_cast<uint16_t>(originX_ + width_); }
+
+    // Raw access for bulk writers; call markDirty() for the region you touched.
+    uint8_t* data() { return buffer_.data(); }
+    const uint8_t* data() const { return buffer_.data(); }
+    const std::vector<uint8_t>& buffer() const { return buffer_; }
+
+    void clear();
+    void fill(bool on = true);
+
+    void setPixel(int16_t x, int16_t y, bool on = true) {
+        x -= originX_;
+        if (x < 0 || y < 0 || x >= static_cast<int16_t>(width_) || y >= static_cast<int16_t>(height_)) {
+            return;
+        }
+        uint8_t& cell = buffer_[static_cast<size_t>(x) * byteRows_ + (y >> 3)];
+        const uint8_t mask = 0x80 >> (y & 7);
+        const uint8_t previous = cell;
+        cell = on ? (cell | mask) : (cell & ~mask);
+        if (cell != previous) {
+            markColumnDirty(x, y >> 3);
+        }
+    }
+
+    bool getPixel(int16_t x, int16_t y) const {
+        x -= originX_;
+        if (x < 0 || y < 0 || x >= static_cast<int16_t>(width_) || y >= static_cast<int16_t>(height_)) {
+            return false;
+        }
+        return buffer_[static_cast<size_t>(x) * byteRows_ + (y >> 3)] & (0x80 >> (y & 7));
+    }
+
+    // Axis-aligned fills, clipped once to the buffer. Each column is written a whole byte (eight
+    // pixel rows) at a time with one precomputed mask per byte row, so filling the full buffer
+    // costs about as much as fill().
+    void fillRect(int16_t x, int16_t y, uint16_t w, uint16_t h, bool on = true);
+    void drawHorizontalLine(int16_t x, int16_t y, uint16_t w, bool on = true) { fillRect(x, y, w, 1, on); }
+    void drawVerticalLine(int16_t x, int16_t y, uint16_t h, bool on = true) { fillRect(x, y, 1, h, on); }
+
+    // Packs a byte-per-pixel row-major bitmap (the legacy drawing format) into this buffer.
+    bool loadBitmap(const std::vector<uint8_t>& bitmap);
+
+    // Dirty-region tracking. Spans are kept per byte row (8 pixel rows) as [x0, x1] columns.
+    bool isDirty() const;
+    bool dirtySpan(uint8_t byteRow, uint16_t& x0, uint16_t& x1) const;
+    void markDirty();
+    void markDirty(int16_t x, int16_t y, uint16_t w, uint16_t h);
+    void clearDirty();
+
+    void markColumnDirty(int16_t x, uint8_t byteRow) {
+        if (x < dirtyMin_[byteRow]) dirtyMin_[byteRow] = x;
+        if (x > dirtyMax_[byteRow]) dirtyMax_[byteRow] = x;
+    }
+
+private:
+    void applyMask(uint8_t& cell, uint8_t mask, bool on, int16_t x, uint8_t byteRow) {
+        const uint8_t updated = on ? (cell | mask) : (cell & ~mask);
+        if (updated != cell) {
+            cell = updated;
+            markColumnDirty(x, byteRow);
+        }
+    }
+
+    uint16_t width_;
+    uint16_t height_;
+    uint16_t byteRows_;
+    int16_t originX_;
+    uint16_t screenWidth_;
+    std::vector<uint8_t> buffer_;
+    int16_t dirtyMin_[MAX_HEIGHT / 8];
+    int16_t dirtyMax_[MAX_HEIGHT / 8];
+};
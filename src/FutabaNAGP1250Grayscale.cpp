@@ -0,0 +1,115 @@
+#include "FutabaNAGP1250Grayscale.h"
+
+#include "FutabaNAGP1250.h"
+
+FutabaNAGP1250GrayCanvas::FutabaNAGP1250GrayCanvas(uint16_t width, uint16_t height, uint8_t bits)
+    : bits_(constrain(bits, static_cast<uint8_t>(1), MAX_BITS)) {
+    planes_.reserve(bits_);
+    for (uint8_t k = 0; k < bits_; ++k) {
+        planes_.emplace_back(width, height);
+    }
+}
+
+void FutabaNAGP1250GrayCanvas::clear() {
+    for (uint8_t k = 0; k < bits_; ++k) {
+        planes_[k].clear();
+    }
+}
+
+void FutabaNAGP1250GrayCanvas::setPixel(int16_t x, int16_t y, uint8_t level) {
+    for (uint8_t k = 0; k < bits_; ++k) {
+        planes_[k].setPixel(x, y, (level >> k) & 1);
+    }
+}
+
+uint8_t FutabaNAGP1250GrayCanvas::getPixel(int16_t x, int16_t y) const {
+    uint8_t level = 0;
+    for (uint8_t k = 0; k < bits_; ++k) {
+        level |= planes_[k].getPixel(x, y) << k;
+    }
+    return level;
+}
+
+void FutabaNAGP1250GrayCanvas::fillRect(int16_t x, int16_t y, uint16_t w, uint16_t h, uint8_t level) {
+    for (uint8_t k = 0; k < bits_; ++k) {
+        planes_[k].fillRect(x, y, w, h, (level >> k) & 1);
+    }
+}
+
+FutabaNAGP1250GrayScheduler::FutabaNAGP1250GrayScheduler(FutabaNAGP1250& display, FutabaNAGP1250GrayCanvas& canvas)
+    : display_(display),
+      canvas_(canvas),
+      shown_(canvas.width(), canvas.height()),
+      slot_(0),
+      started_(false),
+      partialUploads_(true),
+      slotStartUs_(0),
+      slotUs_(0),
+      fixedSlotUs_(0),
+      periodStartUs_(0),
+      periodMaxUploadUs_(0),
+      lastUploadUs_(0),
+      periods_(0),
+      refreshHz_(0),
+      flickerThresholdHz_(50) {}
+
+bool FutabaNAGP1250GrayScheduler::service() {
+    const uint32_t now = micros();
+    if (started_ && now - slotStartUs_ < slotTime()) {
+        return false;
+    }
+
+    const uint16_t slots = canvas_.levels() - 1;
+    slot_ = slot_ % slots + 1;
+    if (slot_ == 1) {
+        if (started_) {
+            refreshHz_ = 1000000.0f / max(now - periodStartUs_, static_cast<uint32_t>(1));
+            ++periods_;
+        }
+        periodStartUs_ = now;
+        slotUs_ = periodMaxUploadUs_;
+        periodMaxUploadUs_ = 0;
+        started_ = true;
+    }
+    slotStartUs_ = now;
+
+    // Slot s (1-based) shows the plane given by the number of trailing zeros of s, counted from
+    // the most significant plane: the top plane gets every second slot, the next every fourth...
+    uint8_t plane = canvas_.bits() - 1;
+    for (uint16_t s = slot_; (s & 1) == 0; s >>= 1) {
+        --plane;
+    }
+
+    const uint32_t start = micros();
+    upload(plane);
+    lastUploadUs_ = micros() - start;
+    periodMaxUploadUs_ = max(periodMaxUploadUs_, lastUploadUs_);
+    return true;
+}
+
+void FutabaNAGP1250GrayScheduler::upload(uint8_t plane) {
+    const FutabaNAGP1250Framebuffer& source = canvas_.plane(plane);
+    if (!partialUploads_) {
+        FutabaNAGP1250::Batch batch(display_);
+        display_.setCursorPosition(0, 0);
+        display_.displayGraphicImage(source);
+        // Keep the copy current, so partial uploads can be turned back on at any time.
+        memcpy(shown_.data(), source.data(), static_cast<size_t>(shown_.width()) * shown_.byteRows());
+        shown_.clearDirty();
+        return;
+    }
+
+    // Bring the copy of what is on screen up to date, marking only the bytes that change.
+    const uint8_t byteRows = shown_.byteRows();
+    const uint8_t* in = source.data();
+    uint8_t* out = shown_.data();
+    for (uint16_t x = 0; x < shown_.width(); ++x) {
+        for (uint8_t row = 0; row < byteRows; ++row, ++in, ++out) {
+            if (*out != *in) {
+                *out = *in;
+                shown_.markColumnDirty(x, row);
+            }
+        }
+    }
+    display_.flush(shown_);
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <Arduino.h>
+#include <vector>
+
+#include "FutabaNAGP1250Framebuffer.h"
+
+class FutabaNAGP1250;
+
+/**
+ * Grayscale canvas stored as bit planes.
+ *
+ * A pixel of level `l` (0..levels() - 1) sets bit `k` of `l` in plane `k`, so every plane is an
+ * ordinary packed framebuffer and all framebuffer drawing helpers can be used on them directly.
+ * `FutabaNAGP1250GrayScheduler` turns the planes into gray levels on the display.
+ */
+class FutabaNAGP1250GrayCanvas {
+public:
+    static constexpr uint8_t MAX_BITS = 3;
+
+    // `bits` is 1..3, i.e. 2, 4 or 8 gray levels. Only those planes are allocated.
+    FutabaNAGP1250GrayCanvas(uint16_t width = 140, uint16_t height = 32, uint8_t bits = 2);
+
+    uint16_t width() const { return planes_[0].width(); }
+    uint16_t height() const { return planes_[0].height(); }
+    uint8_t bits() const { return bits_; }
+    uint8_t levels() const { return 1 << bits_; }
+
+    void clear();
+    void setPixel(int16_t x, int16_t y, uint8_t level);
+    uint8_t getPixel(int16_t x, int16_t y) const;
+    void fillRect(int16_t x, int16_t y, uint16_t w, uint16_t h, uint8_t level);
+
+    // Plane `bit` (0 = least significant).
+    FutabaNAGP1250Framebuffer& plane(uint8_t bit) { return planes_[bit < bits_ ? bit : 0]; }
+    const FutabaNAGP1250Framebuffer& plane(uint8_t bit) const { return planes_[bit < bits_ ? bit : 0]; }
+
+private:
+    uint8_t bits_;
+    std::vector<FutabaNAGP1250Framebuffer> planes_;
+};
+
+/**
+ * Shows a `FutabaNAGP1250GrayCanvas` by time-multiplexing its planes (PWM across frames).
+ *
+ * One gray period is `levels() - 1` equal slots and plane `k` is on screen for `2^k` of them.
+ * The slots are interleaved in bit-angle order (for 3 bits: 2 1 2 0 2 1 2) so the brightest
+ * plane never sits on screen in one long block. Every slot boundary uploads the next plane,
+ * either as a full frame or, by default, through `FutabaNAGP1250::flush` so only the bytes that
+ * differ from the plane on screen are sent.
+ *
+ * By default the slot time follows the slowest upload of the previous period, which is the
+ * highest refresh rate the link sustains; refreshRate() reports the achieved gray periods per
+ * second and flickerFree() compares it with the flicker threshold.
+ */
+class FutabaNAGP1250GrayScheduler {
+public:
+    FutabaNAGP1250GrayScheduler(FutabaNAGP1250& display, FutabaNAGP1250GrayCanvas& canvas);
+
+    // Call as often as possible from loop(); returns true if a plane was uploaded.
+    bool service();
+
+    // Fixed slot length in microseconds; 0 (default) adapts to the upload time.
+    void setSlotTime(uint32_t us) { fixedSlotUs_ = us; }
+    uint32_t slotTime() const { return fixedSlotUs_ ? fixedSlotUs_ : slotUs_; }
+    void setPartialUploads(bool enabled) { partialUploads_ = enabled; }
+    void setFlickerThreshold(float hz) { flickerThresholdHz_ = hz; }
+
+    float refreshRate() const { return refreshHz_; }
+    bool flickerFree() const { return refreshHz_ >= flickerThresholdHz_; }
+    uint32_t periods() const { return periods_; }
+    uint32_t lastUploadUs() const { return lastUploadUs_; }
+
+private:
+    void upload(uint8_t plane);
+
+    FutabaNAGP1250& display_;
+    FutabaNAGP1250GrayCanvas& canvas_;
+    FutabaNAGP1250Framebuffer shown_;
+
+    uint16_t slot_;
+    bool started_;
+    bool partialUploads_;
+    uint32_t slotStartUs_;
+    uint32_t slotUs_;
+    uint32_t fixedSlotUs_;
+    uint32_t periodStartUs_;
+    uint32_t periodMaxUploadUs_;
+    uint32_t lastUploadUs_;
+    uint32_t periods_;
+    float refreshHz_;
+    float flickerThresholdHz_;
+};
@@ -0,0 +1,49 @@
+#include "FutabaNAGP1250ScrollCanvas.h"
+
+#include "FutabaNAGP1250.h"
+
+FutabaNAGP1250ScrollCanvas::FutabaNAGP1250ScrollCanvas(FutabaNAGP1250& display, RenderCallback render,
+                                                       void* context, uint16_t viewWidth)
+    : display_(display),
+      render_(render),
+      context_(context),
+      // The hidden columns right of the view must fit a whole step.
+      viewWidth_(constrain(viewWidth, static_cast<uint16_t>(1),
+                           static_cast<uint16_t>(FutabaNAGP1250::WIDTH_EXTENDED - MAX_STEP))),
+      position_(0),
+      strip_(MAX_STEP, FutabaNAGP1250::HEIGHT) {}
+
+void FutabaNAGP1250ScrollCanvas::begin(uint32_t x) {
+    position_ = x;
+    display_.defineBaseWindow(FutabaNAGP1250::BASE_WINDOW_MODE_EXTENDED);
+    redraw();
+}
+
+void FutabaNAGP1250ScrollCanvas::redraw() {
+    FutabaNAGP1250::Batch batch(display_);
+    for (uint16_t column = 0; column < viewWidth_; column += MAX_STEP) {
+        upload(position_ + column, column, static_cast<uint8_t>(min(static_cast<uint16_t>(viewWidth_ - column),
+                                                                      static_cast<uint16_t>(MAX_STEP))));
+    }
+}
+
+void FutabaNAGP1250ScrollCanvas::scroll(uint8_t columns, uint8_t speed) {
+    columns = constrain(columns, static_cast<uint8_t>(1), MAX_STEP);
+    FutabaNAGP1250::Batch batch(display_);
+    // Display coordinates follow the scroll, so the hidden columns are always right of the view.
+    upload(position_ + viewWidth_, viewWidth_, columns);
+    display_.displayScroll(FutabaNAGP1250::HEIGHT / 8, columns, speed);
+    position_ += columns;
+}
+
+void FutabaNAGP1250ScrollCanvas::upload(uint32_t x, uint16_t column, uint8_t width) {
+    strip_.clear();
+    if (render_) {
+        render_(strip_, x, context_);
+    }
+    // Redundant with the shadow state unless something else changed them.
+    display_.selectWindow(0);
+    display_.setWriteLogic(FutabaNAGP1250::WRITE_MODE_NORMAL);
+    display_.setCursorPosition(column, 0);
+    display_.displayGraphicImage(strip_.data(), width, FutabaNAGP1250::HEIGHT);
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include "FutabaNAGP1250Framebuffer.h"
+
+class FutabaNAGP1250;
+
+/**
+ * Horizontally scrolling virtual canvas, as wide as needed, shown through the display.
+ *
+ * The display is switched to the extended base window, so display RAM holds 256 columns of
+ * which only the first `viewWidth` are visible. Each step renders just the columns about to
+ * appear into a small strip, uploads it into the hidden columns right of the view, and then
+ * moves the view with the hardware display scroll. A one-column step costs a cursor move, a
+ * 4-byte bit image and the scroll command (28 bytes) instead of a full frame, and the new
+ * columns are already in place when they come into view.
+ *
+ * The canvas content comes from a render callback that draws canvas columns
+ * `x .. x + strip.width() - 1` into a cleared strip, e.g. a ticker drawing its text at `-x` or
+ * a trend graph plotting the samples for those columns. The display scroll moves everything on
+ * screen, so the canvas owns the whole display while it is in use.
+ */
+class FutabaNAGP1250ScrollCanvas {
+public:
+    // Widest step and strip: the most columns scroll() reveals at once.
+    static constexpr uint8_t MAX_STEP = 32;
+
+    typedef void (*RenderCallback)(FutabaNAGP1250Framebuffer& strip, uint32_t x, void* context);
+
+    FutabaNAGP1250ScrollCanvas(FutabaNAGP1250& display, RenderCallback render, void* context = nullptr,
+                               uint16_t viewWidth = 140);
+
+    // Selects the extended base window and draws the view starting at canvas column `x`.
+    void begin(uint32_t x = 0);
+    // Reveals the next `columns` (1..MAX_STEP) canvas columns. The hardware scroll moves one
+    // column per step, `speed` (0..255) sets the delay between steps.
+    void scroll(uint8_t columns = 1, uint8_t speed = 0);
+    // Re-renders and uploads the visible columns, e.g. after the content changed.
+    void redraw();
+
+    // Canvas column shown at the left edge of the view.
+    uint32_t position() const { return position_; }
+    uint16_t viewWidth() const { return viewWidth_; }
+
+private:
+    // Renders canvas columns `x .. x + width - 1` and uploads them at display column `column`.
+    void upload(uint32_t x, uint16_t column, uint8_t width);
+
+    FutabaNAGP1250& display_;
+    RenderCallback render_;
+    void* context_;
+    uint16_t viewWidth_;
+    uint32_t position_;
+    FutabaNAGP1250Framebuffer strip_;
+};
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * Display-link counters kept by `FutabaNAGP1250` and its transport.
+ *
+ * Bytes are attributed to a command type when the command is issued (batched commands included);
+ * transactions, SBUSY stalls, fixed byte delays and timeouts are recorded where they happen.
+ * Stall durations are also kept as a histogram with power-of-four buckets: bucket 0 counts
+ * stalls below 16us, bucket `k` those in [4^(k+1), 4^(k+2)) us, the last bucket everything
+ * from 65ms up.
+ *
+ * The counters are only collected when the library is built with FUTABA_NAGP1250_STATS=1 (e.g.
+ * `-DFUTABA_NAGP1250_STATS=1` in build_flags); otherwise they stay at zero. Only the driver's
+ * source file reads the flag, so class layouts and header code do not depend on it.
+ */
+struct FutabaNAGP1250Stats {
+    enum Command : uint8_t {
+        COMMAND_TEXT = 0,   // printable characters
+        COMMAND_IMAGE,      // bit image headers and payload
+        COMMAND_CURSOR,
+        COMMAND_WINDOW,     // window select, define and clear
+        COMMAND_ACTION,     // scroll, blink, curtain and wait
+        COMMAND_OTHER,      // settings, control codes, raw sendAsync data
+        COMMAND_COUNT,
+    };
+
+    static constexpr uint8_t STALL_BUCKETS = 8;
+
+    uint32_t bytes[COMMAND_COUNT];
+    uint32_t transactions;
+    uint32_t stalls;
+    uint32_t stallUs;
+    uint32_t maxStallUs;
+    uint32_t stallHistogram[STALL_BUCKETS];
+    uint32_t delayUs;       // byte spacing spent in delayMicroseconds() without SBUSY
+    uint32_t timeouts;      // busy waits that gave up
+    uint32_t sinceUs;       // micros() at the last reset
+
+    FutabaNAGP1250Stats() { reset(); }
+
+    void reset() {
+        memset(this, 0, sizeof(*this));
+        sinceUs = micros();
+    }
+
+    uint32_t totalBytes() const {
+        uint32_t total = 0;
+        for (uint8_t i = 0; i < COMMAND_COUNT; ++i) {
+            total += bytes[i];
+        }
+        return total;
+    }
+
+    // Bytes issued per second of wall time since the last reset.
+    float bytesPerSecond() const {
+        const uint32_t elapsed = micros() - sinceUs;
+        return elapsed ? totalBytes() * 1000000.0f / elapsed : 0;
+    }
+
+    void recordStall(uint32_t us) {
+        ++stalls;
+        stallUs += us;
+        if (us > maxStallUs) maxStallUs = us;
+        uint8_t bucket = 0;
+        for (uint32_t limit = 16; bucket < STALL_BUCKETS - 1 && us >= limit; limit <<= 2) {
+            ++bucket;
+        }
+        ++stallHistogram[bucket];
+    }
+};
@@ -0,0 +1,34 @@
+#include "FutabaNAGP1250StripRenderer.h"
+
+#include "FutabaNAGP1250.h"
+
+FutabaNAGP1250StripRenderer::FutabaNAGP1250StripRenderer(FutabaNAGP1250& display, RenderCallback render,
+                                                         void* context, uint16_t stripWidth)
+    : display_(display), render_(render), context_(context), strip_(stripWidth, FutabaNAGP1250::HEIGHT) {}
+
+void FutabaNAGP1250StripRenderer::setRender(RenderCallback render, void* context) {
+    render_ = render;
+    context_ = context;
+}
+
+void FutabaNAGP1250StripRenderer::draw(uint16_t x, uint16_t width) {
+    if (x >= FutabaNAGP1250::WIDTH_EXTENDED || width == 0) {
+        return;
+    }
+    width = min(width, static_cast<uint16_t>(FutabaNAGP1250::WIDTH_EXTENDED - x));
+    const uint8_t byteRows = strip_.byteRows();
+
+    // One bit image for the whole area; the strips are its consecutive column ranges.
+    display_.setCursorPosition(x, 0);
+    display_.beginGraphicImageStream(width, byteRows);
+    for (uint16_t done = 0; done < width; done += strip_.width()) {
+        const uint16_t columns = min(strip_.width(), static_cast<uint16_t>(width - done));
+        strip_.setOrigin(x + done, x + width);
+        strip_.clear();
+        if (render_) {
+            render_(strip_, context_);
+        }
+        display_.writeGraphicImageStream(strip_.data(), static_cast<size_t>(columns) * byteRows);
+    }
+    display_.endGraphicImageStream();
+}
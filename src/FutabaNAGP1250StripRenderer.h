@@ -0,0 +1,56 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include "FutabaNAGP1250Framebuffer.h"
+
+// Columns rendered per strip. Each column takes 4 bytes of RAM.
+#ifndef FUTABA_NAGP1250_STRIP_WIDTH
+#ifdef __AVR__
+#define FUTABA_NAGP1250_STRIP_WIDTH 16
+#else
+#define FUTABA_NAGP1250_STRIP_WIDTH 32
+#endif
+#endif
+
+class FutabaNAGP1250;
+
+/**
+ * Draws full-screen graphics through a buffer a few columns wide, for boards that cannot hold a
+ * frame (an Uno has 2 KB of SRAM; a 140x32 byte-per-pixel bitmap alone takes 4480 bytes).
+ *
+ * The render callback draws the whole screen in screen coordinates, with the usual framebuffer
+ * helpers. It is called once per strip, with the strip's origin set (see
+ * `FutabaNAGP1250Framebuffer::setOrigin`), so everything outside the strip is clipped away
+ * cheaply. Each finished strip is streamed as the next part of one bit image, so the display
+ * receives exactly the bytes of a full-frame upload while the strip takes 64 bytes on AVR.
+ *
+ *     FutabaNAGP1250StripRenderer strips(vfd, [](FutabaNAGP1250Framebuffer& strip, void*) {
+ *         FutabaNAGP1250::drawGraphicCircle(strip, 70, 16, 15);
+ *         FutabaNAGP1250::drawGraphicLine(strip, 0, 31, 139, 0);
+ *     });
+ *     strips.draw();
+ *
+ * A display list works the same way: pass it as the context and draw every entry. The callback
+ * must draw the same picture on every call, and draw every pixel it needs each time, because
+ * each strip starts cleared.
+ */
+class FutabaNAGP1250StripRenderer {
+public:
+    typedef void (*RenderCallback)(FutabaNAGP1250Framebuffer& strip, void* context);
+
+    FutabaNAGP1250StripRenderer(FutabaNAGP1250& display, RenderCallback render, void* context = nullptr,
+                                uint16_t stripWidth = FUTABA_NAGP1250_STRIP_WIDTH);
+
+    // Renders screen columns `x .. x + width - 1` strip by strip and uploads them at column `x`.
+    void draw(uint16_t x = 0, uint16_t width = 140);
+
+    void setRender(RenderCallback render, void* context = nullptr);
+    uint16_t stripWidth() const { return strip_.width(); }
+
+private:
+    FutabaNAGP1250& display_;
+    RenderCallback render_;
+    void* context_;
+    FutabaNAGP1250Framebuffer strip_;
+};
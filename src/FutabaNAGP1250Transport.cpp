@@ -0,0 +1,144 @@
+#include "FutabaNAGP1250Transport.h"
+
+// Interrupt handlers must live in IRAM on the Espressif cores.
+#if defined(ESP32) || defined(ESP8266)
+#define FUTABA_NAGP1250_ISR IRAM_ATTR
+#else
+#define FUTABA_NAGP1250_ISR
+#endif
+
+FutabaNAGP1250SbusyIrqFlow* FutabaNAGP1250SbusyIrqFlow::instances_[FutabaNAGP1250SbusyIrqFlow::MAX_INSTANCES];
+
+template <uint8_t Slot>
+void FUTABA_NAGP1250_ISR FutabaNAGP1250SbusyIrqFlow::onEdge() {
+    FutabaNAGP1250SbusyIrqFlow* flow = instances_[Slot];
+    if (!flow) {
+        return;
+    }
+    flow->ready_ = true;
+    const FutabaNAGP1250Transport::ReadyCallback callback = flow->readyCallback_;
+    if (callback) {
+        callback(flow->readyContext_);
+    }
+}
+
+void FutabaNAGP1250SbusyIrqFlow::begin() {
+    FutabaNAGP1250SbusyFlow::begin();
+    if (attached_) {
+        return;
+    }
+    const int interrupt = digitalPinToInterrupt(pin_);
+#ifdef NOT_AN_INTERRUPT
+    if (interrupt == NOT_AN_INTERRUPT) {
+        return; // not an interrupt pin: keep polling
+    }
+#endif
+    static void (*const handlers[MAX_INSTANCES])() = {&onEdge<0>, &onEdge<1>};
+    for (uint8_t slot = 0; slot < MAX_INSTANCES; ++slot) {
+        if (!instances_[slot]) {
+            instances_[slot] = this;
+            attachInterrupt(interrupt, handlers[slot], FALLING);
+            attached_ = true;
+            return;
+        }
+    }
+}
+
+bool FutabaNAGP1250SbusyIrqFlow::waitReady(uint32_t start, uint32_t timeoutUs) {
+    while (busy()) {
+        // Clear first, then re-check the pin: an edge in between is either seen here or sets
+        // the flag again, so it cannot be lost.
+        ready_ = false;
+        if (!busy()) {
+            break;
+        }
+        while (!ready_ && (attached_ || busy())) {
+            if (micros() - start > timeoutUs) {
+                return false;
+            }
+            if (idle_) {
+                idle_();
+            } else {
+                yield();
+            }
+        }
+    }
+    return true;
+}
+
+bool FutabaNAGP1250SbusyIrqFlow::waitIdle(uint32_t timeoutUs) {
+    if (!busy()) {
+        return true;
+    }
+    const uint32_t start = micros();
+    const bool ready = waitReady(start, timeoutUs);
+    recordStall(start, true);
+    return ready;
+}
+
+FutabaNAGP1250EmulatorTransport::FutabaNAGP1250EmulatorTransport(FutabaNAGP1250Emulator& emulator,
+                                                                 uint32_t busFrequency)
+    : emulator_(emulator),
+      byteTimeNs_(static_cast<uint32_t>(8000000000ULL / max(busFrequency, static_cast<uint32_t>(1)))),
+      fractionNs_(0),
+      nowUs_(0),
+      stallUs_(0),
+      stats_(nullptr) {}
+
+void FutabaNAGP1250EmulatorTransport::stall(uint32_t us) {
+    stallUs_ += us;
+    nowUs_ += us;
+    if (stats_) {
+        stats_->recordStall(us);
+    }
+}
+
+void FutabaNAGP1250EmulatorTransport::sendByte(uint8_t byte) {
+    if (emulator_.busy(nowUs_)) {
+        stall(emulator_.readyAtUs() - nowUs_);
+    }
+    fractionNs_ += byteTimeNs_;
+    nowUs_ += fractionNs_ / 1000;
+    fractionNs_ %= 1000;
+    emulator_.write(byte, nowUs_);
+}
+
+void FutabaNAGP1250EmulatorTransport::write(const uint8_t* data, size_t blocks, size_t blockLength, size_t stride) {
+    for (size_t block = 0; block < blocks; ++block) {
+        const uint8_t* src = data + block * stride;
+        for (size_t i = 0; i < blockLength; ++i) {
+            sendByte(src[i]);
+        }
+    }
+}
+
+size_t FutabaNAGP1250EmulatorTransport::writeAvailable(const uint8_t* data, size_t length) {
+    size_t sent = 0;
+    while (sent < length && !emulator_.busy(nowUs_)) {
+        sendByte(data[sent++]);
+    }
+    if (sent == 0 && length) {
+        // Nothing else runs on the virtual clock, so a poll that finds the display busy stands
+        // for the caller doing other work until it is ready again.
+        nowUs_ = emulator_.readyAtUs();
+    }
+    return sent;
+}
+
+bool FutabaNAGP1250EmulatorTransport::busy() {
+    return emulator_.busy(nowUs_);
+}
+
+bool FutabaNAGP1250EmulatorTransport::waitIdle(uint32_t timeoutUs) {
+    // Same contract as polling the SBUSY pin: done once the line drops.
+    if (!emulator_.busy(nowUs_)) {
+        return true;
+    }
+    const uint32_t wait = emulator_.readyAtUs() - nowUs_;
+    if (wait > timeoutUs) {
+        stall(timeoutUs);
+        return false;
+    }
+    stall(wait);
+    return true;
+}
@@ -0,0 +1,432 @@
+#pragma once
+
+#include <Arduino.h>
+#include <SPI.h>
+
+#include "FutabaNAGP1250Emulator.h"
+#include "FutabaNAGP1250Stats.h"
+
+/**
+ * Byte transport used by `FutabaNAGP1250`.
+ *
+ * The driver only talks to the display through this interface, one call per command or
+ * image block. Concrete transports are composed at compile time from a bus policy (how a byte
+ * gets on the wire) and a flow-control policy (how the display is kept from overflowing), so
+ * each combination compiles to its own straight-line hot loop without per-byte configuration
+ * checks, and combinations a sketch never names are not linked in.
+ */
+class FutabaNAGP1250Transport {
+public:
+    virtual ~FutabaNAGP1250Transport() {}
+
+    virtual void begin() {}
+    virtual void beginTransaction() {}
+    virtual void endTransaction() {}
+
+    // Blocking, flow-controlled write of `blocks` runs of `blockLength` bytes whose starts are
+    // `stride` bytes apart in `data` (a plain buffer is one block).
+    virtual void write(const uint8_t* data, size_t blocks, size_t blockLength, size_t stride) = 0;
+    void write(const uint8_t* data, size_t length) { write(data, 1, length, length); }
+
+    // Non-blocking write: sends bytes only while the display can take them without waiting
+    // and returns how many were sent.
+    virtual size_t writeAvailable(const uint8_t* data, size_t length) = 0;
+
+    // True while the display cannot accept another byte.
+    virtual bool busy() = 0;
+    // Waits until SBUSY is released (immediately true without flow control); false on timeout.
+    virtual bool waitIdle(uint32_t timeoutUs) = 0;
+
+    virtual void setBurstLimit(uint8_t maxBytes) { (void)maxBytes; }
+    virtual uint8_t burstSize() const { return 1; }
+
+    // Where SBUSY stalls and byte delays are recorded. The driver only sets it when the library
+    // is built with FUTABA_NAGP1250_STATS; until then it is null and nothing is counted.
+    virtual void setStats(FutabaNAGP1250Stats* stats) { (void)stats; }
+
+    typedef void (*ReadyCallback)(void* context);
+    // Transports with an SBUSY edge interrupt call `callback` from that interrupt whenever the
+    // display becomes ready again; the others ignore it.
+    virtual void setReadyCallback(ReadyCallback callback, void* context) {
+        (void)callback;
+        (void)context;
+    }
+};
+
+// ---------------------------------------------------------------------------------------
+// Bus policies
+// ---------------------------------------------------------------------------------------
+
+// Hardware SPI, LSB first, mode 0.
+class FutabaNAGP1250SpiBus {
+public:
+    FutabaNAGP1250SpiBus(SPIClass& spi, uint32_t frequency)
+        : spi_(spi), settings_(frequency, LSBFIRST, SPI_MODE0) {}
+
+    void begin() { spi_.begin(); }
+    void beginTransaction() { spi_.beginTransaction(settings_); }
+    void endTransaction() { spi_.endTransaction(); }
+    void transfer(uint8_t byte) { spi_.transfer(byte); }
+    // `buffer` is overwritten with the received bytes.
+    void transfer(uint8_t* buffer, size_t length) { spi_.transfer(buffer, length); }
+
+private:
+    SPIClass& spi_;
+    SPISettings settings_;
+};
+
+// Bit-banged GPIO, LSB first, data sampled on the rising clock edge.
+class FutabaNAGP1250BitBangBus {
+public:
+    FutabaNAGP1250BitBangBus(uint8_t dataPin, uint8_t clockPin) : dataPin_(dataPin), clockPin_(clockPin) {}
+
+    void begin() {
+        pinMode(dataPin_, OUTPUT);
+        pinMode(clockPin_, OUTPUT);
+        digitalWrite(clockPin_, LOW);
+    }
+    void beginTransaction() {}
+    void endTransaction() {}
+    void transfer(uint8_t byte) {
+        for (uint8_t bit = 0; bit < 8; ++bit, byte >>= 1) {
+            digitalWrite(dataPin_, byte & 0x01);
+            digitalWrite(clockPin_, HIGH);
+            digitalWrite(clockPin_, LOW);
+        }
+    }
+    void transfer(uint8_t* buffer, size_t length) {
+        for (size_t i = 0; i < length; ++i) {
+            transfer(buffer[i]);
+        }
+    }
+
+private:
+    uint8_t dataPin_;
+    uint8_t clockPin_;
+};
+
+// ---------------------------------------------------------------------------------------
+// Flow-control policies
+// ---------------------------------------------------------------------------------------
+
+// SBUSY wired: data goes out in bursts with one busy check per chunk. The chunk size adapts to
+// how quickly the display's input buffer fills: it halves whenever SBUSY is still asserted
+// right after a chunk and doubles after a run of chunks that left it low.
+class FutabaNAGP1250SbusyFlow {
+public:
+    static constexpr uint8_t MAX_CHUNK = 32;
+
+    explicit FutabaNAGP1250SbusyFlow(uint8_t sbusyPin)
+        : pin_(sbusyPin), burstLimit_(MAX_CHUNK), burstSize_(8), quietBursts_(0), stats_(nullptr) {}
+
+    void begin() { pinMode(pin_, INPUT); }
+    void setStats(FutabaNAGP1250Stats* stats) { stats_ = stats; }
+    bool busy() const { return digitalRead(pin_) == HIGH; }
+    uint8_t chunkSize() const { return burstSize_; }
+
+    template <typename Bus>
+    void send(Bus& bus, uint8_t* chunk, uint8_t count) {
+        if (stats_ && busy()) {
+            const uint32_t start = micros();
+            while (busy()) {}
+            stats_->recordStall(micros() - start);
+        }
+        while (busy()) {}
+        transmit(bus, chunk, count);
+    }
+
+    void sent() {}
+
+    bool waitIdle(uint32_t timeoutUs) const {
+        const uint32_t start = micros();
+        bool stalled = false;
+        while (busy()) {
+            stalled = true;
+            if (micros() - start > timeoutUs) {
+                recordStall(start, stalled);
+                return false;
+            }
+            delayMicroseconds(10);
+        }
+        recordStall(start, stalled);
+        return true;
+    }
+
+    void setBurstLimit(uint8_t maxBytes) {
+        burstLimit_ = constrain(maxBytes, static_cast<uint8_t>(1), static_cast<uint8_t>(MAX_CHUNK));
+        burstSize_ = min(burstSize_, burstLimit_);
+        quietBursts_ = 0;
+    }
+    uint8_t burstSize() const { return burstSize_; }
+    void setReadyCallback(FutabaNAGP1250Transport::ReadyCallback, void*) {}
+
+protected:
+    // Sends one chunk (SBUSY already low) and adapts the chunk size to how busy it left the display.
+    template <typename Bus>
+    void transmit(Bus& bus, uint8_t* chunk, uint8_t count) {
+        if (count == 1) {
+            bus.transfer(chunk[0]);
+        } else {
+            bus.transfer(chunk, count);
+        }
+
+        if (busy()) {
+            burstSize_ = max(static_cast<uint8_t>(burstSize_ / 2), static_cast<uint8_t>(1));
+            quietBursts_ = 0;
+        } else if (++quietBursts_ >= 8 && burstSize_ < burstLimit_) {
+            burstSize_ = min(static_cast<uint8_t>(burstSize_ * 2), burstLimit_);
+            quietBursts_ = 0;
+        }
+    }
+
+    void recordStall(uint32_t start, bool stalled) const {
+        if (stats_ && stalled) {
+            stats_->recordStall(micros() - start);
+        }
+    }
+
+    uint8_t pin_;
+    uint8_t burstLimit_;
+    uint8_t burstSize_;
+    uint8_t quietBursts_;
+    FutabaNAGP1250Stats* stats_;
+};
+
+// SBUSY wired to an interrupt-capable pin: the same adaptive bursts, but instead of spinning on
+// the pin while the display is busy, the transmitter waits for the falling SBUSY edge. Waiting
+// runs the idle hook, which defaults to yield() and can put the MCU to sleep (any interrupt,
+// including the SBUSY edge, must wake it). The edge also fires the transport's ready callback,
+// which FutabaNAGP1250::setServiceFromInterrupt() uses to resume asynchronous transfers.
+// Up to MAX_INSTANCES flows can be active; further ones, and pins without an external interrupt,
+// fall back to polling the pin.
+class FutabaNAGP1250SbusyIrqFlow : public FutabaNAGP1250SbusyFlow {
+public:
+    static constexpr uint8_t MAX_INSTANCES = 2;
+
+    typedef void (*IdleHook)();
+
+    explicit FutabaNAGP1250SbusyIrqFlow(uint8_t sbusyPin, IdleHook idle = nullptr)
+        : FutabaNAGP1250SbusyFlow(sbusyPin), idle_(idle), attached_(false), ready_(false),
+          readyCallback_(nullptr), readyContext_(nullptr) {}
+
+    void begin();
+
+    template <typename Bus>
+    void send(Bus& bus, uint8_t* chunk, uint8_t count) {
+        if (busy()) {
+            const uint32_t start = micros();
+            waitReady(start, 0xFFFFFFFFUL);
+            recordStall(start, true);
+        }
+        transmit(bus, chunk, count);
+    }
+
+    bool waitIdle(uint32_t timeoutUs);
+
+    void setReadyCallback(FutabaNAGP1250Transport::ReadyCallback callback, void* context) {
+        readyCallback_ = nullptr;
+        readyContext_ = context;
+        readyCallback_ = callback;
+    }
+    bool interruptAttached() const { return attached_; }
+
+private:
+    template <uint8_t Slot>
+    static void onEdge();
+    bool waitReady(uint32_t start, uint32_t timeoutUs);
+
+    static FutabaNAGP1250SbusyIrqFlow* instances_[MAX_INSTANCES];
+
+    IdleHook idle_;
+    bool attached_;
+    volatile bool ready_;
+    FutabaNAGP1250Transport::ReadyCallback volatile readyCallback_;
+    void* volatile readyContext_;
+};
+
+// SBUSY not connected: a fixed delay after every byte. VFDs can be slow to process bytes,
+// especially in read-modify-write modes (OR/AND/XOR), so the default is a safe 400us.
+class FutabaNAGP1250TimedFlow {
+public:
+    static constexpr uint8_t MAX_CHUNK = 32;
+
+    explicit FutabaNAGP1250TimedFlow(uint16_t byteDelayUs = 400)
+        : byteDelayUs_(byteDelayUs), lastByteUs_(0), stats_(nullptr) {}
+
+    void begin() { lastByteUs_ = micros() - byteDelayUs_; }
+    void setStats(FutabaNAGP1250Stats* stats) { stats_ = stats; }
+    bool busy() const { return micros() - lastByteUs_ < byteDelayUs_; }
+    uint8_t chunkSize() const { return MAX_CHUNK; }
+
+    template <typename Bus>
+    void send(Bus& bus, uint8_t* chunk, uint8_t count) {
+        for (uint8_t i = 0; i < count; ++i) {
+            bus.transfer(chunk[i]);
+            delayMicroseconds(byteDelayUs_);
+        }
+        lastByteUs_ = micros();
+        if (stats_) {
+            stats_->delayUs += static_cast<uint32_t>(count) * byteDelayUs_;
+        }
+    }
+
+    void sent() { lastByteUs_ = micros(); }
+    bool waitIdle(uint32_t) const { return true; }
+    void setBurstLimit(uint8_t) {}
+    uint8_t burstSize() const { return 1; }
+    void setReadyCallback(FutabaNAGP1250Transport::ReadyCallback, void*) {}
+
+private:
+    uint16_t byteDelayUs_;
+    uint32_t lastByteUs_;
+    FutabaNAGP1250Stats* stats_;
+};
+
+// ---------------------------------------------------------------------------------------
+// Bus + flow-control composition
+// ---------------------------------------------------------------------------------------
+
+template <typename Bus, typename Flow>
+class FutabaNAGP1250BusTransport : public FutabaNAGP1250Transport {
+public:
+    FutabaNAGP1250BusTransport(const Bus& bus, const Flow& flow) : bus_(bus), flow_(flow) {}
+
+    void begin() override {
+        bus_.begin();
+        flow_.begin();
+    }
+    void beginTransaction() override { bus_.beginTransaction(); }
+    void endTransaction() override { bus_.endTransaction(); }
+
+    using FutabaNAGP1250Transport::write;
+    void write(const uint8_t* data, size_t blocks, size_t blockLength, size_t stride) override {
+        // Chunks are gathered into a scratch buffer: it flattens strided sources and protects
+        // the caller's data from SPIClass::transfer(buf, n), which overwrites its buffer.
+        uint8_t chunk[Flow::MAX_CHUNK];
+        size_t block = 0;
+        size_t offset = 0;
+        while (block < blocks) {
+            const uint8_t chunkSize = flow_.chunkSize();
+            uint8_t count = 0;
+            while (count < chunkSize && block < blocks) {
+                const size_t take = min(static_cast<size_t>(chunkSize - count), blockLength - offset);
+                memcpy(chunk + count, data + block * stride + offset, take);
+                count += take;
+                offset += take;
+                if (offset == blockLength) {
+                    offset = 0;
+                    ++block;
+                }
+            }
+            flow_.send(bus_, chunk, count);
+        }
+    }
+
+    size_t writeAvailable(const uint8_t* data, size_t length) override {
+        size_t sent = 0;
+        while (sent < length && !flow_.busy()) {
+            bus_.transfer(data[sent++]);
+            flow_.sent();
+        }
+        return sent;
+    }
+
+    bool busy() override { return flow_.busy(); }
+    bool waitIdle(uint32_t timeoutUs) override { return flow_.waitIdle(timeoutUs); }
+    void setBurstLimit(uint8_t maxBytes) override { flow_.setBurstLimit(maxBytes); }
+    uint8_t burstSize() const override { return flow_.burstSize(); }
+    void setStats(FutabaNAGP1250Stats* stats) override { flow_.setStats(stats); }
+    void setReadyCallback(ReadyCallback callback, void* context) override {
+        flow_.setReadyCallback(callback, context);
+    }
+
+private:
+    Bus bus_;
+    Flow flow_;
+};
+
+typedef FutabaNAGP1250BusTransport<FutabaNAGP1250SpiBus, FutabaNAGP1250SbusyFlow> FutabaNAGP1250SpiSbusyTransport;
+typedef FutabaNAGP1250BusTransport<FutabaNAGP1250SpiBus, FutabaNAGP1250SbusyIrqFlow> FutabaNAGP1250SpiSbusyIrqTransport;
+typedef FutabaNAGP1250BusTransport<FutabaNAGP1250SpiBus, FutabaNAGP1250TimedFlow> FutabaNAGP1250SpiTimedTransport;
+typedef FutabaNAGP1250BusTransport<FutabaNAGP1250BitBangBus, FutabaNAGP1250SbusyFlow> FutabaNAGP1250BitBangSbusyTransport;
+typedef FutabaNAGP1250BusTransport<FutabaNAGP1250BitBangBus, FutabaNAGP1250SbusyIrqFlow> FutabaNAGP1250BitBangSbusyIrqTransport;
+typedef FutabaNAGP1250BusTransport<FutabaNAGP1250BitBangBus, FutabaNAGP1250TimedFlow> FutabaNAGP1250BitBangTimedTransport;
+
+// ---------------------------------------------------------------------------------------
+// Capture sink
+// ---------------------------------------------------------------------------------------
+
+// Records the bytes instead of sending them, so commands can be encoded with the full driver API
+// in one place (e.g. a producer task) and transmitted somewhere else. Bytes beyond the capacity
+// are dropped and flagged by overflowed().
+class FutabaNAGP1250CaptureTransport : public FutabaNAGP1250Transport {
+public:
+    FutabaNAGP1250CaptureTransport(uint8_t* buffer, size_t capacity)
+        : buffer_(buffer), capacity_(capacity), length_(0), overflowed_(false) {}
+
+    using FutabaNAGP1250Transport::write;
+    void write(const uint8_t* data, size_t blocks, size_t blockLength, size_t stride) override {
+        for (size_t block = 0; block < blocks; ++block) {
+            writeAvailable(data + block * stride, blockLength);
+        }
+    }
+    size_t writeAvailable(const uint8_t* data, size_t length) override {
+        const size_t take = min(length, capacity_ - length_);
+        memcpy(buffer_ + length_, data, take);
+        length_ += take;
+        overflowed_ |= take < length;
+        return length;
+    }
+    bool busy() override { return false; }
+    bool waitIdle(uint32_t) override { return true; }
+
+    const uint8_t* data() const { return buffer_; }
+    size_t length() const { return length_; }
+    bool overflowed() const { return overflowed_; }
+    void clear() {
+        length_ = 0;
+        overflowed_ = false;
+    }
+
+private:
+    uint8_t* buffer_;
+    size_t capacity_;
+    size_t length_;
+    bool overflowed_;
+};
+
+// ---------------------------------------------------------------------------------------
+// Emulator sink
+// ---------------------------------------------------------------------------------------
+
+// Feeds a FutabaNAGP1250Emulator on a virtual clock instead of real time. Every byte advances
+// the clock by its modelled wire time; waiting on SBUSY jumps the clock to the moment the
+// emulated input buffer has room again and is accumulated in stallUs().
+class FutabaNAGP1250EmulatorTransport : public FutabaNAGP1250Transport {
+public:
+    explicit FutabaNAGP1250EmulatorTransport(FutabaNAGP1250Emulator& emulator, uint32_t busFrequency = 1000000);
+
+    using FutabaNAGP1250Transport::write;
+    void write(const uint8_t* data, size_t blocks, size_t blockLength, size_t stride) override;
+    size_t writeAvailable(const uint8_t* data, size_t length) override;
+    bool busy() override;
+    bool waitIdle(uint32_t timeoutUs) override;
+    void setStats(FutabaNAGP1250Stats* stats) override { stats_ = stats; }
+
+    FutabaNAGP1250Emulator& emulator() { return emulator_; }
+    uint32_t nowUs() const { return nowUs_; }
+    uint32_t stallUs() const { return stallUs_; }
+    // Lets virtual time pass, e.g. to model work done between frames.
+    void advance(uint32_t us) { nowUs_ += us; }
+
+private:
+    void sendByte(uint8_t byte);
+    void stall(uint32_t us);
+
+    FutabaNAGP1250Emulator& emulator_;
+    uint32_t byteTimeNs_;
+    uint32_t fractionNs_;
+    uint32_t nowUs_;
+    uint32_t stallUs_;
+    FutabaNAGP1250Stats* stats_;
+};